@@ -0,0 +1,162 @@
+#include "assets.h"
+
+Assets::Assets(Pack* p, Tracer* t)
+{
+    this->p_Pack = p;
+    this->t_Tracer = t;
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        this->s_Samples[i] = nullptr;
+    }
+    for(int i = 0; i < ASSET_NULL; i++)
+    {
+        this->b_Taken[i] = false;
+    }
+
+    this->f_Files = al_get_new_file_interface();
+    this->m_Lock = al_create_mutex();
+    this->c_Loaded = al_create_cond();
+    this->t_Loader = al_create_thread(Assets::load, this);
+    if(this->t_Loader)
+    {
+        al_start_thread(this->t_Loader);
+    }
+    //No thread to spare. Load everything here and now instead.
+    else
+    {
+        Assets::load(nullptr, this);
+    }
+}
+
+Assets::~Assets()
+{
+    //Stop at the next asset, and wait for the one loading now.
+    if(this->t_Loader)
+    {
+        al_join_thread(this->t_Loader, nullptr);
+        al_destroy_thread(this->t_Loader);
+    }
+
+    //Destroy whatever was loaded but never handed over.
+    if(!this->b_Taken[ASSET_FONT] && this->f_Font)
+    {
+        al_destroy_font(this->f_Font);
+    }
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        if(!this->b_Taken[ASSET_SFX+i] && this->s_Samples[i])
+        {
+            al_destroy_sample(this->s_Samples[i]);
+        }
+    }
+
+    al_destroy_cond(this->c_Loaded);
+    al_destroy_mutex(this->m_Lock);
+}
+
+
+//How many assets have loaded so far.
+unsigned int Assets::getDone()
+{
+    al_lock_mutex(this->m_Lock);
+    unsigned int done = this->ui_Done;
+    al_unlock_mutex(this->m_Lock);
+    return done;
+}
+
+//Blocks until an asset has loaded.
+void Assets::wait(unsigned int ui_asset)
+{
+    al_lock_mutex(this->m_Lock);
+    while(this->ui_Done <= ui_asset)
+    {
+        al_wait_cond(this->c_Loaded, this->m_Lock);
+    }
+    al_unlock_mutex(this->m_Lock);
+}
+
+//Hands over the font, waiting for it if need be.
+ALLEGRO_FONT* Assets::takeFont()
+{
+    this->wait(ASSET_FONT);
+    this->b_Taken[ASSET_FONT] = true;
+    return this->f_Font;
+}
+
+//Hands over a sound effect, waiting for it if need be.
+ALLEGRO_SAMPLE* Assets::takeSample(int i)
+{
+    this->wait(ASSET_SFX+i);
+    this->b_Taken[ASSET_SFX+i] = true;
+    return this->s_Samples[i];
+}
+
+
+//Opens a file stored as is in the pack, in place.
+ALLEGRO_FILE* Assets::openFile(Pack* p, const char* name)
+{
+    const PACK_ENTRY* e = p ? p->find(name) : nullptr;
+    if(!e || e->rate)
+    {
+        return nullptr;
+    }
+    //Only ever read, so the mapping being read only doesn't matter.
+    return al_open_memfile((void*)p->getData(e), e->size, "r");
+}
+
+//Makes a sample that plays decoded PCM straight out of the pack.
+ALLEGRO_SAMPLE* Assets::openSample(Pack* p, const char* name)
+{
+    const PACK_ENTRY* e = p ? p->find(name) : nullptr;
+    if(!e || !e->rate || (e->channels != 1 && e->channels != 2) || (e->bits != 8 && e->bits != 16))
+    {
+        return nullptr;
+    }
+    ALLEGRO_AUDIO_DEPTH depth = e->bits == 8 ? ALLEGRO_AUDIO_DEPTH_UINT8 : ALLEGRO_AUDIO_DEPTH_INT16;
+    ALLEGRO_CHANNEL_CONF channels = e->channels == 1 ? ALLEGRO_CHANNEL_CONF_1 : ALLEGRO_CHANNEL_CONF_2;
+    //The sample never frees or writes to its buffer, so it can point right into the mapping.
+    return al_create_sample((void*)p->getData(e), e->size/(e->channels*e->bits/8), e->rate, depth, channels, false);
+}
+
+//Loads every asset in order. Runs on the loader thread.
+void* Assets::load(ALLEGRO_THREAD* t, void* arg)
+{
+    Assets* a = static_cast<Assets*>(arg);
+
+    //A new thread starts on the standard file interface, so load through the same one the game does.
+    al_set_new_file_interface(a->f_Files);
+    a->t_Tracer->name("Assets");
+    for(int i = 0; i < ASSET_NULL; i++)
+    {
+        if(t && al_get_thread_should_stop(t))
+        {
+            break;
+        }
+        const char* file = i == ASSET_FONT ? "Flipbash.ttf" : c_SFX[i-ASSET_SFX].file;
+        a->t_Tracer->begin(file);
+
+        //Out of the pack if it's there, off the disk if not.
+        if(i == ASSET_FONT)
+        {
+            ALLEGRO_FILE* f = Assets::openFile(a->p_Pack, file);
+            a->f_Font = f ? al_load_ttf_font_f(f,file,UTIL_BLOCK_SIZE,0) : al_load_ttf_font(file,UTIL_BLOCK_SIZE,0);
+        }
+        else
+        {
+            a->s_Samples[i-ASSET_SFX] = Assets::openSample(a->p_Pack, file);
+            if(!a->s_Samples[i-ASSET_SFX])
+            {
+                a->s_Samples[i-ASSET_SFX] = al_load_sample(file);
+            }
+        }
+
+        a->t_Tracer->end(file);
+
+        //Publish it. Anything waiting on it can go on.
+        al_lock_mutex(a->m_Lock);
+        a->ui_Done = i+1;
+        al_broadcast_cond(a->c_Loaded);
+        al_unlock_mutex(a->m_Lock);
+    }
+    return nullptr;
+}
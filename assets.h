@@ -0,0 +1,74 @@
+/*
+
+    ==================
+    ===== ASSETS =====
+    ==================
+
+    Everything read out of the asset pack at startup, loaded on a thread of
+     its own so the window can open, and show how far along it is,
+     straight away.
+    Assets load one at a time in a fixed order, the ones a game needs to
+     start going first. Each is handed over once it's in, and whatever
+     was never handed over is destroyed along with the loader.
+    Anything not in the pack, or everything if there isn't one, is read
+     from Pentris.dat and decoded instead.
+
+*/
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <allegro5/allegro_ttf.h>
+#include <allegro5/allegro_audio.h>
+#include <allegro5/allegro_memfile.h>
+
+#include <utilities.h>
+#include <sfx.h>
+#include <pack.h>
+#include <tracer.h>
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+
+//Every asset, in the order they load.
+enum e_Asset
+{
+    ASSET_FONT,
+    ASSET_SFX,                                  //First sound effect. The rest follow in e_SFX order.
+    ASSET_NULL = ASSET_SFX+SFX_NULL,
+};
+
+#define ASSETS_NEEDED       (ASSET_SFX+SFX_START_TIMER+1)       //Assets a game can't start without: the font, and the countdown sound.
+
+
+class Assets
+{
+    public:
+    Assets(Pack* p, Tracer* t);     //Constructor. Needs every addon the assets use to be started. Starts loading, from the pack if it's open.
+    ~Assets();                      //Destructor. Stops loading, and destroys anything not handed over.
+
+    unsigned int getDone();                     //How many assets have loaded so far.
+    void wait(unsigned int ui_asset);           //Blocks until an asset has loaded.
+    ALLEGRO_FONT* takeFont();                   //Hands over the font, waiting for it if need be.
+    ALLEGRO_SAMPLE* takeSample(int i);          //Hands over a sound effect, waiting for it if need be.
+
+    static ALLEGRO_FILE* openFile(Pack* p, const char* name);       //Opens a file stored as is in the pack, in place. nullptr if it isn't there.
+    static ALLEGRO_SAMPLE* openSample(Pack* p, const char* name);   //Makes a sample that plays decoded PCM straight out of the pack. nullptr if it isn't there.
+
+
+    private:
+    static void* load(ALLEGRO_THREAD* t, void* arg);        //Loads every asset in order. Runs on the loader thread.
+
+    Pack*                           p_Pack                  = nullptr;      //Archive to load from first. Not owned; has to outlive every asset.
+    Tracer*                         t_Tracer                = nullptr;      //Traces each asset loading as a span. Not owned.
+    ALLEGRO_FONT*                   f_Font                  = nullptr;      //The font.
+    ALLEGRO_SAMPLE*                 s_Samples[SFX_NULL]     ;               //Every sound effect, decoded.
+    bool                            b_Taken[ASSET_NULL]     ;               //Has each asset been handed over?
+    unsigned int                    ui_Done                 = 0;            //Assets loaded so far. Guarded by m_Lock.
+    ALLEGRO_THREAD*                 t_Loader                = nullptr;      //Thread doing the loading.
+    ALLEGRO_MUTEX*                  m_Lock                  = nullptr;      //Guards ui_Done.
+    ALLEGRO_COND*                   c_Loaded                = nullptr;      //Signalled each time an asset loads.
+    const ALLEGRO_FILE_INTERFACE*   f_Files                 = nullptr;      //File interface to load through. Allegro keeps one per thread.
+};
+
+#endif //ASSETS_H
@@ -0,0 +1,44 @@
+#include "atlas.h"
+
+Atlas::Atlas()
+{
+    //Start with a fully transparent strip of tiles.
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    this->setSprite(al_create_bitmap(ATLAS_SLOTS*UTIL_BLOCK_SIZE, UTIL_BLOCK_SIZE));
+    al_set_target_bitmap(this->getSprite());
+    al_clear_to_color(al_premul_rgba(0,0,0,0));
+
+    for(int i = 0; i < ATLAS_SLOTS; i++)
+    {
+        //Pick the color of this tile.
+        ALLEGRO_COLOR clr;
+        if(i == ATLAS_SLOT_SHADOW)
+        {
+            clr = al_premul_rgba(100,100,100,100);
+        }
+        else
+        {
+            PENTOMINO_TINT t = m_Tint[i == ATLAS_SLOT_NULL ? PENTOMINO_NULL : i];
+            clr = al_map_rgb(t.uc_Red,t.uc_Green,t.uc_Blue);
+        }
+
+        //Draw the actual block, leaving a transparent frame around it.
+        ALLEGRO_BITMAP* sub = al_create_sub_bitmap(this->getSprite(), i*UTIL_BLOCK_SIZE+1, 1, UTIL_BLOCK_SIZE-2, UTIL_BLOCK_SIZE-2);
+        al_set_target_bitmap(sub);
+        al_clear_to_color(clr);
+        al_destroy_bitmap(sub);
+        sub = nullptr;
+    }
+
+    //Load a custom skin on the atlas.
+    //this->setSprite(al_load_bitmap("blocks.png"));
+
+    al_set_target_bitmap(target);
+}
+
+Atlas::~Atlas()
+{
+    //Destroy the sprites.
+    al_destroy_bitmap(this->getSprite());
+    this->setSprite(nullptr);
+}
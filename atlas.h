@@ -0,0 +1,60 @@
+/*
+
+    =================
+    ===== ATLAS =====
+    =================
+
+    Every block sprite the game draws lives side by side in one bitmap:
+     one pre-tinted tile per pentomino type, one for blacked out blocks,
+     and one for shadows.
+    Drawing straight out of a single bitmap lets each window be drawn
+     in one held batch instead of one draw call per block.
+
+*/
+
+#include <allegro5/allegro.h>
+
+#include <utilities.h>
+#include <pentomino.h>
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#define ATLAS_SLOT_NULL     (PENTOMINO_TYPES)   //Tile for blacked out blocks.
+#define ATLAS_SLOT_SHADOW   (PENTOMINO_TYPES+1) //Tile for the current pentomino's shadow.
+#define ATLAS_SLOTS         (PENTOMINO_TYPES+2) //Total number of tiles.
+
+
+class Atlas
+{
+    public:
+    Atlas();    //Constructor. Needs a display to exist.
+    ~Atlas();   //Destructor
+
+    void drawBlock(unsigned char uc_type, float x, float y)     //Draws a block of the given type.
+    {
+        this->drawSlot(uc_type < ATLAS_SLOT_NULL ? uc_type : ATLAS_SLOT_NULL, x, y);
+    }
+    void drawShadow(float x, float y)                           //Draws a block of shadow.
+    {
+        this->drawSlot(ATLAS_SLOT_SHADOW, x, y);
+    }
+
+
+    //Gets
+    ALLEGRO_BITMAP* getSprite()             {return this->bmp_Atlas;}
+
+    //Sets
+    void setSprite(ALLEGRO_BITMAP* bmp)     {this->bmp_Atlas = bmp;}
+
+
+    private:
+    void drawSlot(int i, float x, float y)
+    {
+        al_draw_bitmap_region(this->bmp_Atlas, i*UTIL_BLOCK_SIZE, 0, UTIL_BLOCK_SIZE, UTIL_BLOCK_SIZE, x, y, 0);
+    }
+
+    ALLEGRO_BITMAP*     bmp_Atlas   = nullptr;      //All tiles, left to right.
+};
+
+#endif //ATLAS_H
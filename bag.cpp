@@ -0,0 +1,128 @@
+#include "bag.h"
+
+Bag::Bag()
+{
+    //Seed the RNG.
+    this->seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+}
+
+
+//Reseeds the RNG.
+void Bag::seed(unsigned long long ull)
+{
+    this->mt_Generator.seed(ull);
+}
+
+
+//Draws the next pentomino, refilling the bag first if it's empty.
+unsigned char Bag::draw()
+{
+    //Fill the bag if it's empty.
+    if(!this->getBagsize())
+    {
+        this->fill();
+    }
+
+    //Draw the next pentomino out of the bag.
+    this->setBagsize(this->getBagsize()-1);
+    return this->getBag(this->getBagsize());
+}
+
+//Loads a fresh bag of 7.
+void Bag::fill()
+{
+    //Load the bag.
+    unsigned char bag[7];
+    //Draw K, N, or W.
+    unsigned char red = this->roll(3);
+
+    switch(red)
+    {
+        case 0:         bag[0] = PENTOMINO_K; break;
+        case 1:         bag[0] = PENTOMINO_N; break;
+        case 2:default: bag[0] = PENTOMINO_W; break;
+    }
+
+    //Draw C, L, or Z.
+    unsigned char orange = this->roll(3);
+
+    switch(orange)
+    {
+        case 0:         bag[1] = PENTOMINO_C; break;
+        case 1:         bag[1] = PENTOMINO_L; break;
+        case 2:default: bag[1] = PENTOMINO_Z; break;
+    }
+
+    //Draw P or Q.
+    unsigned char yellow = this->roll(2);
+
+    switch(yellow)
+    {
+        case 0:         bag[2] = PENTOMINO_P; break;
+        case 1:default: bag[2] = PENTOMINO_Q; break;
+    }
+
+    //Draw F or U.
+    unsigned char green = this->roll(2);
+
+    switch(green)
+    {
+        case 0:         bag[3] = PENTOMINO_F; break;
+        case 1:default: bag[3] = PENTOMINO_U; break;
+    }
+
+    //Draw J, S, or V.
+    unsigned char blue = this->roll(3);
+
+    switch(blue)
+    {
+        case 0:         bag[4] = PENTOMINO_J; break;
+        case 1:         bag[4] = PENTOMINO_S; break;
+        case 2:default: bag[4] = PENTOMINO_V; break;
+    }
+
+    //Draw D, T, X, or Y.
+    unsigned char purple = this->roll(4);
+
+    switch(purple)
+    {
+        case 0:         bag[5] = PENTOMINO_D; break;
+        case 1:         bag[5] = PENTOMINO_T; break;
+        case 2:         bag[5] = PENTOMINO_X; break;
+        case 3:default: bag[5] = PENTOMINO_Y; break;
+    }
+
+    //Last piece is always I.
+    bag[6] = PENTOMINO_I;
+
+    //Shuffle the bag, Fisher-Yates style.
+    for(int i = 6; i > 0; i--)
+    {
+        int j = this->roll(i+1);
+        unsigned char t = bag[i];
+        bag[i] = bag[j];
+        bag[j] = t;
+    }
+
+    //Store the bag.
+    for(int i = 0; i < 7; i++)
+    {
+        this->setBag(i,bag[i]);
+    }
+    this->setBagsize(7);
+}
+
+//Draws a number from 0 to n-1, each equally likely.
+unsigned int Bag::roll(unsigned int n)
+{
+    //Throw away the lowest 2^64 mod n values, so what's left divides evenly by n.
+    unsigned long long floor = (0ULL - n) % n;
+    unsigned long long r;
+    do
+    {
+        r = this->mt_Generator();
+    }
+    while(r < floor);
+
+    return r % n;
+}
@@ -0,0 +1,58 @@
+/*
+
+    ===============
+    ===== BAG =====
+    ===============
+
+    Pentominoes are drawn out of a bag of 7.
+    Each bag holds one pentomino from each color group plus an I,
+     shuffled, so no color goes missing for long.
+    Every draw and shuffle is done here from the raw output of the
+     generator, rather than through the standard distributions, whose
+     results differ between standard libraries. The same seed draws the
+     same pentominoes whichever compiler built the game, so replays play
+     back the same everywhere.
+
+*/
+
+#include <random>
+#include <array>
+#include <chrono>
+
+#include <utilities.h>
+#include <pentomino.h>
+
+#ifndef BAG_H
+#define BAG_H
+
+
+class Bag
+{
+    public:
+    Bag();                                  //Constructor
+
+    void          seed(unsigned long long ull); //Reseeds the RNG, so the same seed always draws the same pentominoes.
+    unsigned char draw();                   //Draws the next pentomino, refilling the bag first if it's empty.
+    void          fill();                   //Loads a fresh bag of 7.
+
+
+    //Gets
+    unsigned char   getBag(int i)           {return this->uc_Bag[i];}
+    unsigned char   getBagsize()            {return this->uc_Bagsize;}
+
+    //Sets
+    void setBag(int i, unsigned char uc)    {this->uc_Bag[i] = uc;}
+    void setBagsize(unsigned char uc)       {this->uc_Bagsize = uc;}
+
+
+    private:
+    unsigned int  roll(unsigned int n);     //Draws a number from 0 to n-1, each equally likely.
+
+
+    //Variables
+    std::mt19937_64                                 mt_Generator;           //RNG
+    std::array<unsigned char,7>                     uc_Bag      ;           //The bag holding the next 7 pentominoes.
+    unsigned char                                   uc_Bagsize  = 0;        //Remaining pentominoes in the bag.
+};
+
+#endif //BAG_H
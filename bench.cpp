@@ -0,0 +1,321 @@
+/*
+
+    =================
+    ===== BENCH =====
+    =================
+
+    Times the hot paths of the board one call at a time, on a few fixed
+     boards, so any change to board.cpp has a baseline to be judged
+     against.
+    Each operation runs in batches. Every board in a batch is set up
+     first, untimed, and then the operation runs once on each of them
+     between two readings of the clock, so neither the setup nor the
+     clock itself shows up in the time per call. The median batch is
+     reported along with the fastest, in nanoseconds per call.
+    Results come out in a fixed order, one row per board and operation,
+     so two runs can be diffed directly.
+
+    Usage:
+        pentris-bench [options]
+            --time MS       Time spent on each board and operation. Default 200.
+            --filter S      Only run operations whose name contains S.
+            --format F      csv or json. Default csv.
+            --out FILE      Write results here instead of standard output.
+
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <utilities.h>
+#include <board.h>
+
+#define BENCH_BATCH             64                                      //Calls timed between each pair of clock readings.
+#define BENCH_MIN_BATCHES       16                                      //Fewest batches timed, however long they take.
+
+//A board to run every operation on.
+struct BENCH_FIXTURE
+{
+    const char*     name;       //Name in the results.
+    int             rows;       //Rows of garbage at the bottom, each with one hole, under a ragged top row.
+};
+
+//A board operation, and how to set a board up for it.
+struct BENCH_CASE
+{
+    const char*     name;                                               //Name in the results.
+    int             arg;                                                //Passed to both steps. Lines to clear, for clearLines.
+    void            (*prepare)(Board* b, int arg, unsigned char type);  //Sets a board up. Not timed.
+    int             (*run)(Board* b, int arg, unsigned char type);      //The call being timed.
+};
+
+struct BENCH_OPTIONS
+{
+    unsigned int        ms          = 200;
+    const char*         filter      = nullptr;
+    bool                json        = false;
+    const char*         out         = nullptr;
+};
+
+struct BENCH_RESULT
+{
+    unsigned long long  calls;
+    double              median;
+    double              fastest;
+};
+
+//The near top out board leaves just enough room above the stack to spawn every pentomino.
+static const BENCH_FIXTURE c_Fixtures[] = {
+    {"empty",           0},
+    {"midgame",         8},
+    {"neartop",         UTIL_GRID_HEIGHT-6},
+};
+
+static volatile int vi_Sink = 0;                                        //Takes every result, so no call can be optimized away.
+
+
+//Set up steps.
+static void prepareNone(Board* b, int arg, unsigned char type)
+{
+}
+
+static void prepareSpawn(Board* b, int arg, unsigned char type)
+{
+    b->spawnPentomino(type);
+}
+
+//Pushes the pentomino against the left wall, where rotating has to kick off it.
+static void prepareWall(Board* b, int arg, unsigned char type)
+{
+    b->spawnPentomino(type);
+    while(b->moveLeft());
+}
+
+//Fills the bottom rows, so exactly that many lines clear.
+static void prepareLines(Board* b, int arg, unsigned char type)
+{
+    b->spawnPentomino(type);
+    for(int y = UTIL_GRID_HEIGHT-arg; y < UTIL_GRID_HEIGHT; y++)
+    {
+        for(int x = 0; x < UTIL_GRID_WIDTH; x++)
+        {
+            if(!b->getCell(x,y))
+            {
+                b->setCell(x,y,type);
+            }
+        }
+    }
+}
+
+//Timed calls.
+static int runSpawn(Board* b, int arg, unsigned char type)          {return b->spawnPentomino(type);}
+static int runMoveLeft(Board* b, int arg, unsigned char type)       {return b->moveLeft();}
+static int runMoveRight(Board* b, int arg, unsigned char type)      {return b->moveRight();}
+static int runRotateRight(Board* b, int arg, unsigned char type)    {return b->rotateRight();}
+static int runRotateLeft(Board* b, int arg, unsigned char type)     {return b->rotateLeft();}
+static int runSoftDrop(Board* b, int arg, unsigned char type)       {return b->softDrop();}
+static int runHardDrop(Board* b, int arg, unsigned char type)       {return b->hardDrop();}
+static int runFindShadow(Board* b, int arg, unsigned char type)     {b->findShadow(); return b->getCurrentPentomino()->getShadow();}
+static int runClearLines(Board* b, int arg, unsigned char type)     {return b->clearLines();}
+static int runKillBoard(Board* b, int arg, unsigned char type)      {return b->killBoard();}
+
+static const BENCH_CASE c_Cases[] = {
+    {"spawnPentomino",      0,  prepareNone,    runSpawn},
+    {"moveLeft",            0,  prepareSpawn,   runMoveLeft},
+    {"moveRight",           0,  prepareSpawn,   runMoveRight},
+    {"rotateRight",         0,  prepareSpawn,   runRotateRight},
+    {"rotateLeft",          0,  prepareSpawn,   runRotateLeft},
+    {"rotateRightWall",     0,  prepareWall,    runRotateRight},
+    {"rotateLeftWall",      0,  prepareWall,    runRotateLeft},
+    {"softDrop",            0,  prepareSpawn,   runSoftDrop},
+    {"hardDrop",            0,  prepareSpawn,   runHardDrop},
+    {"findShadow",          0,  prepareSpawn,   runFindShadow},
+    {"clearLines0",         0,  prepareLines,   runClearLines},
+    {"clearLines1",         1,  prepareLines,   runClearLines},
+    {"clearLines2",         2,  prepareLines,   runClearLines},
+    {"clearLines3",         3,  prepareLines,   runClearLines},
+    {"clearLines4",         4,  prepareLines,   runClearLines},
+    {"clearLines5",         5,  prepareLines,   runClearLines},
+    {"killBoard",           0,  prepareNone,    runKillBoard},
+};
+
+
+//Builds a fixture. The same board every time, so runs can be compared.
+static void build(Board* b, const BENCH_FIXTURE& f)
+{
+    b->reset();
+
+    unsigned int seed = 1;
+    for(int r = 0; r < f.rows; r++)
+    {
+        seed = seed*1103515245 + 12345;
+        int hole = (seed >> 16) % UTIL_GRID_WIDTH;
+        for(int x = 0; x < UTIL_GRID_WIDTH; x++)
+        {
+            if(x != hole)
+            {
+                b->setCell(x, UTIL_GRID_HEIGHT-1-r, (x+r) % PENTOMINO_TYPES);
+            }
+        }
+    }
+
+    //Every other column one higher, so the surface isn't flat.
+    if(f.rows > 0)
+    {
+        for(int x = 1; x < UTIL_GRID_WIDTH; x += 2)
+        {
+            b->setCell(x, UTIL_GRID_HEIGHT-1-f.rows, x % PENTOMINO_TYPES);
+        }
+    }
+}
+
+//Times one operation on one fixture for about as long as asked.
+static BENCH_RESULT measure(const Board& fixture, const BENCH_CASE& c, unsigned int ms)
+{
+    static Board boards[BENCH_BATCH];
+    std::vector<double> batches;
+    unsigned int type = 0;
+
+    std::chrono::steady_clock::time_point until = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    for(int n = -1; n < BENCH_MIN_BATCHES || std::chrono::steady_clock::now() < until; n++)
+    {
+        //Set every board up first. Pentominoes take turns, so every configuration is covered.
+        for(int i = 0; i < BENCH_BATCH; i++)
+        {
+            boards[i] = fixture;
+            c.prepare(&boards[i], c.arg, (type+i) % PENTOMINO_TYPES);
+        }
+
+        int s = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int i = 0; i < BENCH_BATCH; i++)
+        {
+            s += c.run(&boards[i], c.arg, (type+i) % PENTOMINO_TYPES);
+        }
+        double ns = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start).count();
+        vi_Sink += s;
+        type += BENCH_BATCH;
+
+        //The first batch only warms up.
+        if(n >= 0)
+        {
+            batches.push_back(ns/BENCH_BATCH);
+        }
+    }
+
+    BENCH_RESULT r;
+    r.calls = (unsigned long long)batches.size()*BENCH_BATCH;
+    std::nth_element(batches.begin(), batches.begin() + batches.size()/2, batches.end());
+    r.median = batches[batches.size()/2];
+    r.fastest = *std::min_element(batches.begin(), batches.end());
+    return r;
+}
+
+//Reads the command line. False if it's wrong.
+static bool parse(int argc, char** argv, BENCH_OPTIONS& o)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        const char* a = argv[i];
+        const char* v = (i+1 < argc) ? argv[i+1] : nullptr;
+        if(!v)
+        {
+            return false;
+        }
+
+        if(!strcmp(a, "--time"))            {o.ms = strtoul(v, nullptr, 10);}
+        else if(!strcmp(a, "--filter"))     {o.filter = v;}
+        else if(!strcmp(a, "--out"))        {o.out = v;}
+        else if(!strcmp(a, "--format"))
+        {
+            if(strcmp(v, "csv") && strcmp(v, "json"))
+            {
+                return false;
+            }
+            o.json = !strcmp(v, "json");
+        }
+        else
+        {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+    BENCH_OPTIONS o;
+    if(!parse(argc, argv, o))
+    {
+        fprintf(stderr, "usage: %s [--time MS] [--filter S] [--format csv|json] [--out FILE]\n", argv[0]);
+        return 2;
+    }
+
+    FILE* f = o.out ? fopen(o.out, "w") : stdout;
+    if(!f)
+    {
+        fprintf(stderr, "cannot write %s\n", o.out);
+        return 2;
+    }
+
+    if(o.json)
+    {
+        fprintf(f, "[\n");
+    }
+    else
+    {
+        fprintf(f, "board,operation,calls,median_ns,fastest_ns\n");
+    }
+
+    bool first = true;
+    for(const BENCH_FIXTURE& x : c_Fixtures)
+    {
+        Board fixture;
+        build(&fixture, x);
+
+        for(const BENCH_CASE& c : c_Cases)
+        {
+            if(o.filter && !strstr(c.name, o.filter))
+            {
+                continue;
+            }
+
+            BENCH_RESULT r = measure(fixture, c, o.ms);
+            if(o.json)
+            {
+                fprintf(f, "%s  {\"board\": \"%s\", \"operation\": \"%s\", \"calls\": %llu, \"median_ns\": %.2f, \"fastest_ns\": %.2f}",
+                        first ? "" : ",\n", x.name, c.name, r.calls, r.median, r.fastest);
+            }
+            else
+            {
+                fprintf(f, "%s,%s,%llu,%.2f,%.2f\n", x.name, c.name, r.calls, r.median, r.fastest);
+            }
+            fflush(f);
+            first = false;
+
+            //Progress goes to the console, out of the way of the results.
+            if(o.out)
+            {
+                fprintf(stderr, "%-8s %-16s %10.2f ns\n", x.name, c.name, r.median);
+            }
+        }
+    }
+
+    if(o.json)
+    {
+        fprintf(f, "%s]\n", first ? "" : "\n");
+    }
+    if(o.out)
+    {
+        fclose(f);
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+#include "bgm.h"
+
+BGM::BGM(Pack* p, unsigned char uc_track)
+{
+    this->p_Pack = p;
+    this->f_Files = al_get_new_file_interface();
+    this->select(uc_track);
+}
+
+BGM::~BGM()
+{
+    //Wait out the loader, then close whatever it opened.
+    if(this->t_Loader)
+    {
+        al_join_thread(this->t_Loader, nullptr);
+        al_destroy_thread(this->t_Loader);
+    }
+    if(this->as_Loaded)
+    {
+        al_destroy_audio_stream(this->as_Loaded);
+    }
+    if(this->as_Stream)
+    {
+        al_destroy_audio_stream(this->as_Stream);
+    }
+}
+
+
+//Opens a track in the background. It takes over once it's ready.
+void BGM::select(unsigned char uc_track)
+{
+    this->uc_Wanted = uc_track;
+
+    //Already loading something. It'll be passed over once it finishes, if it isn't this.
+    if(this->t_Loader || uc_track == this->uc_Track)
+    {
+        return;
+    }
+    this->start(uc_track);
+}
+
+//Plays the track from the start, or the selected one as soon as it's ready.
+void BGM::play()
+{
+    this->b_Playing = true;
+    if(this->as_Stream)
+    {
+        al_rewind_audio_stream(this->as_Stream);
+        al_set_audio_stream_playing(this->as_Stream, true);
+    }
+}
+
+//Stops the music.
+void BGM::stop()
+{
+    this->b_Playing = false;
+    if(this->as_Stream)
+    {
+        al_set_audio_stream_playing(this->as_Stream, false);
+    }
+}
+
+//Swaps in a track that has finished opening. Call once a frame.
+void BGM::update()
+{
+    if(!this->t_Loader || !this->b_Loaded.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    al_join_thread(this->t_Loader, nullptr);
+    al_destroy_thread(this->t_Loader);
+    this->t_Loader = nullptr;
+
+    ALLEGRO_AUDIO_STREAM* stream = this->as_Loaded;
+    this->as_Loaded = nullptr;
+
+    //Selection changed while it was loading. Drop it and open the right one.
+    if(this->uc_Loading != this->uc_Wanted)
+    {
+        if(stream)
+        {
+            al_destroy_audio_stream(stream);
+        }
+        if(this->uc_Wanted != this->uc_Track)
+        {
+            this->start(this->uc_Wanted);
+        }
+        return;
+    }
+
+    //Couldn't be opened. Keep the old track.
+    if(!stream)
+    {
+        return;
+    }
+
+    //Close the old track, then attach the new one in its place.
+    if(this->as_Stream)
+    {
+        al_destroy_audio_stream(this->as_Stream);
+    }
+    this->as_Stream = stream;
+    this->uc_Track = this->uc_Loading;
+    al_set_audio_stream_playmode(stream, ALLEGRO_PLAYMODE_LOOP);
+    al_set_audio_stream_gain(stream, UTIL_BGM_VOLUME);
+    al_set_audio_stream_playing(stream, this->b_Playing);
+    al_attach_audio_stream_to_mixer(stream, al_get_default_mixer());
+}
+
+
+//Opens the track being loaded. Runs on the loader thread.
+void* BGM::load(ALLEGRO_THREAD* t, void* arg)
+{
+    BGM* b = static_cast<BGM*>(arg);
+
+    //A new thread starts on the standard file interface, so open through the same one the game does.
+    al_set_new_file_interface(b->f_Files);
+    const char* file = c_BGM[b->uc_Loading];
+    ALLEGRO_FILE* f = Assets::openFile(b->p_Pack, file);
+    b->as_Loaded = f ? al_load_audio_stream_f(f, strrchr(file, '.'), BGM_BUFFERS, BGM_SAMPLES) : al_load_audio_stream(file, BGM_BUFFERS, BGM_SAMPLES);
+    b->b_Loaded.store(true, std::memory_order_release);
+    return nullptr;
+}
+
+//Starts the loader thread on a track.
+void BGM::start(unsigned char uc_track)
+{
+    this->uc_Loading = uc_track;
+    this->b_Loaded.store(false, std::memory_order_relaxed);
+    this->t_Loader = al_create_thread(BGM::load, this);
+    if(this->t_Loader)
+    {
+        al_start_thread(this->t_Loader);
+    }
+}
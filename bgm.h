@@ -0,0 +1,77 @@
+/*
+
+    ===============
+    ===== BGM =====
+    ===============
+
+    The background music, streamed off disk instead of decoded up front.
+    Only a few small fragments of a track are ever decoded at once, and
+     the mixer is fed from those as it plays.
+    Opening a track reads its headers and decodes its first fragments,
+     so a new track is opened on a thread of its own. The old track keeps
+     playing until the new one is ready, then is swapped out and closed.
+    Tracks in the asset pack are streamed out of it in place.
+
+*/
+
+#include <cstring>
+#include <atomic>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_audio.h>
+
+#include <utilities.h>
+#include <assets.h>
+
+#ifndef BGM_H
+#define BGM_H
+
+#define BGM_BUFFERS         4           //Fragments decoded ahead of the mixer.
+#define BGM_SAMPLES         2048        //Samples in each fragment.
+#define BGM_NULL            255         //No track.
+
+
+//File each track is streamed from.
+static const char* const c_BGM[UTIL_BGM_NUMBER] =
+{
+    "type-A.ogg",
+    "type-B.ogg",
+    "type-C.ogg",
+};
+
+
+class BGM
+{
+    public:
+    BGM(Pack* p, unsigned char uc_track);   //Constructor. Needs the audio addon and a mixer to exist. Starts opening the first track.
+    ~BGM();                                 //Destructor
+
+    void select(unsigned char uc_track);        //Opens a track in the background. It takes over once it's ready.
+    void play();                                //Plays the track from the start, or the selected one as soon as it's ready.
+    void stop();                                //Stops the music.
+    void update();                              //Swaps in a track that has finished opening. Call once a frame.
+
+
+    //Gets
+    ALLEGRO_AUDIO_STREAM*       getStream()                 {return this->as_Stream;}
+    unsigned char               getTrack()                  {return this->uc_Track;}
+    bool                        getPlaying()                {return this->b_Playing;}
+
+
+    private:
+    static void* load(ALLEGRO_THREAD* t, void* arg);        //Opens the track being loaded. Runs on the loader thread.
+    void start(unsigned char uc_track);                     //Starts the loader thread on a track.
+
+    Pack*                           p_Pack                  = nullptr;      //Archive to stream from first. Not owned; has to outlive every track.
+    ALLEGRO_AUDIO_STREAM*           as_Stream               = nullptr;      //Track attached to the mixer.
+    ALLEGRO_AUDIO_STREAM*           as_Loaded               = nullptr;      //Track the loader opened, not yet swapped in.
+    ALLEGRO_THREAD*                 t_Loader                = nullptr;      //Thread opening a track, if any.
+    const ALLEGRO_FILE_INTERFACE*   f_Files                 = nullptr;      //File interface to open tracks through. Allegro keeps one per thread.
+    std::atomic<bool>               b_Loaded                {false};        //Has the loader finished?
+    unsigned char                   uc_Track                = BGM_NULL;     //Track attached to the mixer.
+    unsigned char                   uc_Loading              = BGM_NULL;     //Track the loader is opening.
+    unsigned char                   uc_Wanted               = BGM_NULL;     //Track last selected.
+    bool                            b_Playing               = false;        //Should the music be heard?
+};
+
+#endif //BGM_H
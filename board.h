@@ -1,90 +1,121 @@
-
-/*
-
-    =================
-    ===== BOARD =====
-    =================
-
-    All of the action takes place in this board.
-    The board is comprised of a grid of blocks.
-    Forming a full horizontal line of blocks will clear that line.
-
-*/
-
-#include <map>
-#include <iterator>
-
-#include <utilities.h>
-#include <pentomino.h>
-
-#ifndef BOARD_H
-#define BOARD_H
-
-
-class Board
-{
-    public:
-    Board();                //Constructor
-    ~Board();               //Destructor
-
-    bool spawnPentomino(unsigned char uc_type); //Spawns a new pentomino on the top of the board. True if a new pentomino can be spawned.
-    bool softDrop();                            //Moves the current pentomino if possible, or grounds it. True if pentomino is touching something.
-    bool hardDrop();                            //Moves the current pentomino as far down as possible. True if a new pentomino should be spawned.
-    int  clearLines();                          //Tries to clear full lines of dead blocks. Returns the number of lines cleared.
-    bool spinBonus();                           //Checks for spin bonuses. True if there will be a bonus.
-    bool moveLeft();                            //Left key pressed. Attempt to move left. True if move was successful.
-    bool moveRight();                           //Right key pressed. Attempt to move right. True if move was successful.
-    bool rotateRight();                         //Rotate clockwise. True if rotation was successful.
-    bool rotateLeft();                          //Rotate counterclockwise. True if rotation was successful.
-    void findShadow();                          //Finds the shadow of the current pentomino.
-    bool killBoard();                           //Game over. Fill the board with black blocks. True if animation is still in progress.
-
-
-    //Inlines
-    double getSpeed()                {return std::pow(UTIL_GRAVITY_ALPHA - UTIL_GRAVITY_BETA*(this->getLevel()-1),this->getLevel()-1);}
-    void addScore(unsigned int ui)   {this->setScore(this->getScore()+ui);}
-
-    //Gets
-    Block*          getCell(int x, int y)   {return this->m_Board.find(std::make_pair(x,y))->second;}
-    Pentomino*      getCurrentPentomino()   {return this->p_CurrentPentomino;}
-    unsigned char   getLevel()              {return this->uc_Level;}
-    unsigned int    getLines()              {return this->ui_Lines;}
-    char            getLinesRemaining()     {return this->c_LinesRemaining;}
-    unsigned long   getScore()              {return this->l_Score;}
-    unsigned int    getCombo()              {return this->ui_Combo;}
-    unsigned char   getLastScoreType()      {return this->uc_LastScoreType;}
-
-    //Sets
-    void setCell(int x, int y, Block* b)
-    {
-        if(b != nullptr)
-        {
-            b->setX(x);
-            b->setY(y);
-        }
-        this->m_Board.find(std::make_pair(x,y))->second = b;
-    }
-    void setCurrentPentomino(Pentomino* p)  {this->p_CurrentPentomino = p;}
-    void setLevel(unsigned char uc)         {this->uc_Level = uc;}
-    void setLines(unsigned int ui)          {this->ui_Lines = ui;}
-    void setLinesRemaining(char c)          {this->c_LinesRemaining = c;}
-    void setScore(unsigned long l)          {this->l_Score = l;}
-    void setCombo(unsigned int ui)          {this->ui_Combo = ui;}
-    void setLastScoreType(unsigned char uc) {this->uc_LastScoreType = uc;}
-
-
-    //Variables
-    private:
-    std::map<std::pair<int, int>, Block*>   m_Board;    //The entire board and all of its blocks.
-    Pentomino*      p_CurrentPentomino      = nullptr;  //The current pentomino.
-    unsigned char   uc_Level                = 1;        //Current level.
-    unsigned int    ui_Lines                = 0;        //Total lines cleared this game.
-    char            c_LinesRemaining        = 5;        //Lines remaining to level up.
-    unsigned long   l_Score                 = 0;        //Current score.
-    unsigned int    ui_Combo                = 0;        //Current combo.
-    unsigned char   uc_LastScoreType        = 0;        //Tracks the last type of score.
-
-
-};
-
-#endif //BOARD_H
+
+/*
+
+    =================
+    ===== BOARD =====
+    =================
+
+    All of the action takes place in this board.
+    The board is comprised of a grid of blocks.
+    Forming a full horizontal line of blocks will clear that line.
+
+    Dead blocks are stored as one bitmask per row (bit x set means column x
+     is filled), alongside a parallel array recording each cell's type for
+     coloring. The current pentomino is never stamped into the grid until it
+     locks, so every collision test is a handful of shifts and ANDs.
+    The height of the stack in every column is kept up to date as blocks
+     lock and lines clear, so the shadow usually comes straight from the
+     pentomino's bottom edge against those heights.
+
+*/
+
+#include <cstring>
+#include <algorithm>
+
+#include <utilities.h>
+#include <pentomino.h>
+#include <pool.h>
+
+#ifndef BOARD_H
+#define BOARD_H
+
+
+class Board
+{
+    public:
+    Board();                //Constructor
+    Board(const Board& b);  //Copy constructor. The copy gets its own current pentomino.
+    ~Board();               //Destructor
+
+    Board& operator=(const Board& b);           //Copies another board, current pentomino included.
+
+    void reset();                               //Empties the board and its pentomino pool for a new game.
+
+    bool spawnPentomino(unsigned char uc_type); //Spawns a new pentomino on the top of the board. True if a new pentomino can be spawned.
+    bool softDrop();                            //Moves the current pentomino if possible, or grounds it. True if pentomino is touching something.
+    bool hardDrop();                            //Moves the current pentomino as far down as possible. True if a new pentomino should be spawned.
+    int  clearLines();                          //Tries to clear full lines of dead blocks. Returns the number of lines cleared. See getClearedRows().
+    bool spinBonus();                           //Checks for spin bonuses. True if there will be a bonus.
+    bool moveLeft();                            //Left key pressed. Attempt to move left. True if move was successful.
+    bool moveRight();                           //Right key pressed. Attempt to move right. True if move was successful.
+    bool rotateRight();                         //Rotate clockwise. True if rotation was successful.
+    bool rotateLeft();                          //Rotate counterclockwise. True if rotation was successful.
+    void findShadow();                          //Finds the shadow of the current pentomino.
+    void findHeights();                         //Recounts the height of every column from scratch.
+    unsigned char getStackHeight();             //Height of the tallest column.
+    bool killBoard();                           //Game over. Fill the board with black blocks. True if animation is still in progress.
+    void lockPentomino();                       //Turns the current pentomino into dead blocks.
+    bool fits(const int* x, const int* y, int n); //Checks if a set of cells is in bounds and free of dead blocks.
+    bool fits(const PENTOMINO_SHAPE& s, int x, int y); //Checks if a shape with its origin at (x,y) is in bounds and free of dead blocks.
+
+
+    //Inlines
+    double getSpeed()                {return std::pow(UTIL_GRAVITY_ALPHA - UTIL_GRAVITY_BETA*(this->getLevel()-1),this->getLevel()-1);}
+    unsigned int getGravity()        {return std::max(1L, std::lround(this->getSpeed()*UTIL_TICK_RATE));}    //Ticks between each fall at this level.
+    void addScore(unsigned int ui)   {this->setScore(this->getScore()+ui);}
+
+    //Gets
+    bool            getCell(int x, int y)       {return (this->ui_Rows[y+UTIL_GRID_CEILING] >> x) & 1;}
+    unsigned char   getCellType(int x, int y)   {return this->uc_Cells[y+UTIL_GRID_CEILING][x];}
+    unsigned int    getRow(int y)               {return this->ui_Rows[y+UTIL_GRID_CEILING];}
+    unsigned char   getHeight(int x)            {return this->uc_Heights[x];}
+    Pentomino*      getCurrentPentomino()   {return this->p_CurrentPentomino;}
+    unsigned char   getLevel()              {return this->uc_Level;}
+    unsigned int    getLines()              {return this->ui_Lines;}
+    char            getLinesRemaining()     {return this->c_LinesRemaining;}
+    unsigned long   getScore()              {return this->l_Score;}
+    unsigned int    getCombo()              {return this->ui_Combo;}
+    unsigned char   getLastScoreType()      {return this->uc_LastScoreType;}
+    unsigned int    getClearedRows()        {return this->ui_ClearedRows;}
+
+    //Sets
+    void setCell(int x, int y, unsigned char uc)
+    {
+        this->ui_Rows[y+UTIL_GRID_CEILING] |= 1u << x;
+        this->uc_Cells[y+UTIL_GRID_CEILING][x] = uc;
+        this->uc_Heights[x] = std::max<int>(this->uc_Heights[x], UTIL_GRID_HEIGHT-y);
+    }
+    void eraseCell(int x, int y)            {this->ui_Rows[y+UTIL_GRID_CEILING] &= ~(1u << x); this->findHeights();}
+    void setCurrentPentomino(Pentomino* p)  {this->p_CurrentPentomino = p;}
+    void setLevel(unsigned char uc)         {this->uc_Level = uc;}
+    void setLines(unsigned int ui)          {this->ui_Lines = ui;}
+    void setLinesRemaining(char c)          {this->c_LinesRemaining = c;}
+    void setScore(unsigned long l)          {this->l_Score = l;}
+    void setCombo(unsigned int ui)          {this->ui_Combo = ui;}
+    void setLastScoreType(unsigned char uc) {this->uc_LastScoreType = uc;}
+    void setClearedRows(unsigned int ui)    {this->ui_ClearedRows = ui;}
+
+
+    private:
+    bool rotate(bool clockwise);                //Rotates the current pentomino, trying each kickoff in turn.
+    int  scanShadow();                          //Finds the shadow row by row. Needed under overhangs.
+
+
+    //Variables
+    unsigned int    ui_Rows[UTIL_GRID_ROWS]                     ;   //Occupancy of every row, one bit per column.
+    unsigned char   uc_Cells[UTIL_GRID_ROWS][UTIL_GRID_WIDTH]   ;   //Type of every dead block, used for its color.
+    unsigned char   uc_Heights[UTIL_GRID_WIDTH]                 ;   //Height of the stack in every column, counted from the floor.
+    Pool<Pentomino,UTIL_PENTOMINO_POOL> p_Pool  ;       //Storage for the current pentomino, so spawning never allocates.
+    Pentomino*      p_CurrentPentomino      = nullptr;  //The current pentomino.
+    unsigned char   uc_Level                = 1;        //Current level.
+    unsigned int    ui_Lines                = 0;        //Total lines cleared this game.
+    char            c_LinesRemaining        = 5;        //Lines remaining to level up.
+    unsigned long   l_Score                 = 0;        //Current score.
+    unsigned int    ui_Combo                = 0;        //Current combo.
+    unsigned char   uc_LastScoreType        = 0;        //Tracks the last type of score.
+    unsigned int    ui_ClearedRows          = 0;        //Rows removed by the last clear, one bit per visible row as it was before the clear.
+
+
+};
+
+#endif //BOARD_H
@@ -0,0 +1,243 @@
+#include "game.h"
+
+static_assert(ACTION_NULL == REPLAY_ACTIONS, "Replays have to know how many actions there are, to reject any that aren't.");
+
+Game::Game()
+{
+    //Set all held pentominoes to null.
+    for(int i = 0; i < UTIL_HOLD_NUMBER; i++)
+    {
+        this->setHeld(i,PENTOMINO_NULL);
+    }
+}
+
+Game::~Game()
+{
+    //Everything is owned by value; nothing to unload.
+}
+
+
+//Set up a new game, dealt from the given seed.
+void Game::newGame(unsigned long long ull_seed)
+{
+    //Kill current game, if any.
+    this->getBoard()->reset();
+
+    //Start new game.
+    this->setGameOver(false);
+    this->setHolds(UTIL_HOLDS_PER_TURN);
+    for(int i = 0; i < UTIL_HOLD_NUMBER; i++)
+    {
+        this->setHeld(i,PENTOMINO_NULL);
+    }
+
+    this->ull_Seed = ull_seed;
+    this->uc_Input = 0;
+    this->ui_Shift = 0;
+    this->ui_Ticks = 0;
+    this->getBag().seed(ull_seed);
+    this->getBag().setBagsize(0);
+    if(this->getReplay())
+    {
+        this->getReplay()->start(ull_seed);
+    }
+    for(int i = 0; i < UTIL_PREVIEW_NUMBER; i++)
+    {
+        this->drawPentomino();
+    }
+
+    this->spawn();
+}
+
+//Spawn the next pentomino in the order.
+bool Game::spawn()
+{
+    //Die if pentomino cannot be spawned.
+    this->setGameOver(!this->getBoard()->spawnPentomino(this->getOrder(0)));
+    this->drawPentomino();
+
+    //The new pentomino starts falling from scratch.
+    this->ui_Gravity = 0;
+    this->ui_Grounded = 0;
+
+    return !this->getGameOver();
+}
+
+//Apply any action.
+bool Game::act(unsigned char uc_action)
+{
+    //A replay can carry on past the end of its game. Whatever comes after changes nothing.
+    if(this->getGameOver())
+    {
+        return false;
+    }
+
+    switch(uc_action)
+    {
+        case ACTION_LOCK:   this->lock();   return true;
+        case ACTION_HOLD:   this->hold();   return true;
+        default:            return this->move(uc_action);
+    }
+}
+
+//Move, rotate or drop the current pentomino.
+bool Game::move(unsigned char uc_action)
+{
+    //Nothing left to move once the game is over.
+    if(this->getGameOver())
+    {
+        return false;
+    }
+
+    if(this->getReplay())
+    {
+        this->getReplay()->record(uc_action, this->getTicks());
+    }
+
+    ProfilerScope scope(this->getProfiler(), PHASE_MOVE);
+    switch(uc_action)
+    {
+        case ACTION_LEFT:       return this->getBoard()->moveLeft();
+        case ACTION_RIGHT:      return this->getBoard()->moveRight();
+        case ACTION_CW:         return this->getBoard()->rotateRight();
+        case ACTION_CCW:        return this->getBoard()->rotateLeft();
+        case ACTION_SOFT_DROP:  return this->getBoard()->softDrop();
+        case ACTION_HARD_DROP:  return this->getBoard()->hardDrop();
+        default:                return false;
+    }
+}
+
+//Lock the current pentomino, clear lines and spawn the next one.
+int Game::lock()
+{
+    //Nothing left to lock once the game is over.
+    if(this->getGameOver())
+    {
+        return 0;
+    }
+
+    if(this->getReplay())
+    {
+        this->getReplay()->record(ACTION_LOCK, this->getTicks());
+    }
+
+    //Lock this pentomino, try to score and spawn a new one.
+    int l;
+    {
+        ProfilerScope scope(this->getProfiler(), PHASE_CLEAR);
+        this->getBoard()->lockPentomino();
+        l = this->getBoard()->clearLines();
+    }
+
+    this->spawn();
+
+    //Also release holding.
+    this->setHolds(UTIL_HOLDS_PER_TURN);
+
+    return l;
+}
+
+//Store the current pentomino in the hold, and spawn the pentomino from the hold if there is one.
+unsigned char Game::hold()
+{
+    //Nothing left to hold once the game is over.
+    if(this->getGameOver())
+    {
+        return PENTOMINO_NULL;
+    }
+
+    if(this->getReplay())
+    {
+        this->getReplay()->record(ACTION_HOLD, this->getTicks());
+    }
+
+    //Take the oldest pentomino out of the hold and put the current one in.
+    unsigned char type = this->getHeld(0);
+    for(int i = 1; i < UTIL_HOLD_NUMBER; i++)
+    {
+        this->setHeld(i-1,this->getHeld(i));
+    }
+    this->setHeld(UTIL_HOLD_NUMBER-1,this->getBoard()->getCurrentPentomino()->getType());
+
+    if(type != PENTOMINO_NULL)
+    {
+        //Spawn the held pentomino. Die if it cannot be spawned.
+        this->setGameOver(!this->getBoard()->spawnPentomino(type));
+        this->ui_Gravity = 0;
+        this->ui_Grounded = 0;
+    }
+    else
+    {
+        this->spawn();
+    }
+
+    //Restrict holding.
+    this->setHolds(this->getHolds()-1);
+
+    return type;
+}
+
+//Add the next pentomino out of the bag to the order.
+void Game::drawPentomino()
+{
+    memmove(&this->uc_Order[0], &this->uc_Order[1], UTIL_PREVIEW_NUMBER-1);
+    this->uc_Order[UTIL_PREVIEW_NUMBER-1] = this->getBag().draw();
+}
+
+//Run one tick of gravity, auto shift and lock delay with the given keys held.
+unsigned char Game::tick(unsigned char uc_input)
+{
+    unsigned char t = 0;
+    if(this->getGameOver())
+    {
+        return t;
+    }
+    this->ui_Ticks++;
+
+    //Left takes priority over right. A new direction starts the delay over; the first step is the key press itself.
+    unsigned char shift = (uc_input & INPUT_LEFT) ? INPUT_LEFT : (uc_input & INPUT_RIGHT);
+    if(shift != (this->uc_Input & (INPUT_LEFT|INPUT_RIGHT)) || !shift)
+    {
+        this->ui_Shift = 0;
+    }
+    else if(++this->ui_Shift >= UTIL_AUTO_SHIFT_DELAY && (this->ui_Shift - UTIL_AUTO_SHIFT_DELAY)%UTIL_FAST_GRAVITY == 0)
+    {
+        this->move(shift == INPUT_LEFT ? ACTION_LEFT : ACTION_RIGHT);
+        t |= TICK_SHIFTED;
+    }
+
+    //Pressing down starts the pentomino falling quickly, for as long as it's held.
+    bool fast = uc_input & INPUT_DOWN;
+    if(fast && !(this->uc_Input & INPUT_DOWN))
+    {
+        this->ui_Gravity = 0;
+    }
+    this->uc_Input = shift | (uc_input & INPUT_DOWN);
+
+    if(this->ui_Grounded)
+    {
+        //Lock delay. Once it runs out, lock unless the pentomino has been moved off whatever it was resting on.
+        if(++this->ui_Grounded <= UTIL_LOCK_DELAY)
+        {
+            return t;
+        }
+        this->ui_Grounded = 0;
+        this->ui_Gravity = 0;
+        if(this->move(ACTION_SOFT_DROP))
+        {
+            return t | TICK_LOCKED | this->lock();
+        }
+    }
+    else if(++this->ui_Gravity < (fast ? UTIL_FAST_GRAVITY : this->getBoard()->getGravity()))
+    {
+        return t;
+    }
+
+    //Fall one row, or start the lock delay if it can't.
+    this->ui_Gravity = 0;
+    if(this->move(ACTION_SOFT_DROP))
+    {
+        this->ui_Grounded = 1;
+    }
+    return t;
+}
@@ -0,0 +1,121 @@
+/*
+
+    ================
+    ===== GAME =====
+    ================
+
+    The rules of a single game, with no display attached.
+    The game owns the board, the bag, the order of pentominoes to come
+     and the hold, and decides what happens when a pentomino locks.
+    All of it is fixed-size storage that a new game resets in place, so
+     nothing is allocated once the first game has started.
+    Every game is dealt from its own seed, and every action taken on it
+     goes through here, so a replay attached to the game records exactly
+     what is needed to play it out again. A profiler attached the same way
+     times every move and every line clear.
+    Anything that shows the game or plays it (the window, a bot, a batch
+     of simulated games) drives it through here.
+    Time passes in fixed ticks. Gravity, auto shift and lock delay are all
+     counted in whole ticks against the keys held during each one, so the
+     same ticks with the same keys always play out the same way.
+
+*/
+
+#include <cstring>
+
+#include <utilities.h>
+#include <board.h>
+#include <bag.h>
+#include <replay.h>
+#include <profiler.h>
+
+#ifndef GAME_H
+#define GAME_H
+
+//Everything that can happen to a game, in the order a replay stores them.
+enum e_Action
+{
+    ACTION_LEFT,
+    ACTION_RIGHT,
+    ACTION_CW,
+    ACTION_CCW,
+    ACTION_SOFT_DROP,
+    ACTION_HARD_DROP,
+    ACTION_LOCK,
+    ACTION_HOLD,
+    ACTION_NULL
+};
+
+//Keys that can be held through a tick.
+enum e_Input
+{
+    INPUT_LEFT      = 1,
+    INPUT_RIGHT     = 2,
+    INPUT_DOWN      = 4,
+};
+
+//What a tick did, for whatever shows the game to react to. The lowest bits hold the lines cleared.
+enum e_Tick
+{
+    TICK_LINES      = 7,    //Mask of the lines cleared, if a pentomino locked.
+    TICK_SHIFTED    = 8,    //Auto shift moved the pentomino.
+    TICK_LOCKED     = 16,   //The pentomino locked and the next one spawned.
+};
+
+class Game
+{
+    public:
+    Game();     //Constructor
+    ~Game();    //Destructor
+
+    void            newGame(unsigned long long ull_seed);   //Set up a new game, dealt from the given seed.
+    bool            act(unsigned char uc_action);   //Apply any action. Moves and drops return what the board returned; locks and holds return true. Does nothing once the game is over.
+    bool            move(unsigned char uc_action);  //Move, rotate or drop the current pentomino. Returns what the board returned, or false once the game is over.
+    bool            spawn();                        //Spawn the next pentomino in the order. False if it cannot be spawned.
+    int             lock();                         //Lock the current pentomino, clear lines and spawn the next one. Returns the number of lines cleared, or 0 once the game is over.
+    unsigned char   hold();                         //Store the current pentomino in the hold. Returns the pentomino spawned from the hold, or PENTOMINO_NULL if none was held or the game is over.
+    void            drawPentomino();                //Move the order along and add the next pentomino out of the bag to the end.
+    unsigned char   tick(unsigned char uc_input);   //Run one tick of gravity, auto shift and lock delay with the given keys held. Returns what happened.
+
+
+    //Gets
+    Board*                      getBoard()                  {return &this->b_Board;}
+    Bag&                        getBag()                    {return this->b_Bag;}
+    const unsigned char*        getOrder()                  {return this->uc_Order;}
+    unsigned char               getOrder(unsigned char uc)  {return this->uc_Order[uc];}
+    unsigned char               getHeld(unsigned char uc)   {return this->uc_Held[uc];}
+    unsigned char               getHolds()                  {return this->uc_Hold;}
+    bool                        getGameOver()               {return this->b_Dead;}
+    unsigned int                getTicks()                  {return this->ui_Ticks;}
+    unsigned long long          getSeed()                   {return this->ull_Seed;}
+    Replay*                     getReplay()                 {return this->r_Replay;}
+    Profiler*                   getProfiler()               {return this->p_Profiler;}
+
+    //Sets
+    void    setHeld(unsigned char uc, unsigned char p)      {this->uc_Held[uc] = p;}
+    void    setHolds(unsigned char uc)                      {this->uc_Hold = uc;}
+    void    setGameOver(bool b)                             {this->b_Dead = b;}
+    void    setReplay(Replay* r)                            {this->r_Replay = r;}
+    void    setProfiler(Profiler* p)                        {this->p_Profiler = p;}
+
+
+    //Variables
+    private:
+    Board                       b_Board                     ;                       //The board.
+    Bag                         b_Bag                       ;                       //The bag pentominoes are drawn from.
+    unsigned char               uc_Order[UTIL_PREVIEW_NUMBER];                      //Order of pentominoes to come. The last one is the newest.
+    unsigned char               uc_Held[UTIL_HOLD_NUMBER]   ;                       //The held pentominoes.
+    unsigned char               uc_Hold                     = UTIL_HOLDS_PER_TURN;  //Number of holds remaining this turn.
+    bool                        b_Dead                      = false;                //Game over?
+    unsigned long long          ull_Seed                    = 0;                    //Seed this game was dealt from.
+    Replay*                     r_Replay                    = nullptr;              //Records every action, if set. Not owned.
+    Profiler*                   p_Profiler                  = nullptr;              //Times moves and line clears, if set. Not owned.
+    unsigned int                ui_Ticks                    = 0;                    //Ticks run this game. Stamps every action recorded.
+    unsigned char               uc_Input                    = 0;                    //Keys held last tick.
+    unsigned int                ui_Gravity                  = 0;                    //Ticks since the pentomino last fell.
+    unsigned int                ui_Shift                    = 0;                    //Ticks left or right has been held.
+    unsigned int                ui_Grounded                 = 0;                    //Ticks the pentomino has been touching something below it (0 if it isn't).
+
+};
+
+#endif //GAME_H
@@ -0,0 +1,285 @@
+#include "movegen.h"
+
+MoveGen::MoveGen()
+{
+    //Nothing has been seen by any search yet.
+    memset(this->ui_Seen, 0, sizeof(this->ui_Seen));
+    memset(this->ui_Placed, 0, sizeof(this->ui_Placed));
+}
+
+MoveGen::~MoveGen()
+{
+    //Everything is plain data; nothing to unload.
+}
+
+
+//Finds every placement of the board's current pentomino.
+int MoveGen::generate(Board* b)
+{
+    Pentomino* p = b->getCurrentPentomino();
+    if(!p)
+    {
+        //Nothing to place.
+        this->i_Count = 0;
+        return 0;
+    }
+
+    return this->generate(b, p->getType(), p->getX(), p->getY(), p->getOrientation()%4);
+}
+
+//Finds every placement of a pentomino starting from any origin and orientation.
+int MoveGen::generate(Board* b, unsigned char type, int x, int y, char o)
+{
+    //Work on a copy of the rows, so the board is never disturbed.
+    for(int j = -UTIL_GRID_CEILING; j < UTIL_GRID_HEIGHT; j++)
+    {
+        this->ui_Rows[j+UTIL_GRID_CEILING] = b->getRow(j);
+    }
+
+    return this->search(type, x, y, o);
+}
+
+//Same, against bare row masks laid out like the board's, hidden rows first.
+int MoveGen::generate(const unsigned int* rows, unsigned char type, int x, int y, char o)
+{
+    memcpy(this->ui_Rows, rows, sizeof(this->ui_Rows));
+
+    return this->search(type, x, y, o);
+}
+
+//Runs the search against the copied rows.
+int MoveGen::search(unsigned char type, int x, int y, char o)
+{
+    this->uc_Type = type;
+    this->i_Count = 0;
+
+    //Orientations that cover the same cells, relative to their top left corner, lock into the same places.
+    for(int i = 0; i < 4; i++)
+    {
+        this->uc_Canon[i] = i;
+        for(int k = 0; k < i; k++)
+        {
+            const PENTOMINO_SHAPE& a = c_Shapes.shape[type][i];
+            const PENTOMINO_SHAPE& c = c_Shapes.shape[type][k];
+            if(a.right-a.left == c.right-c.left && a.bottom-a.top == c.bottom-c.top && !memcmp(a.mask, c.mask, sizeof(a.mask)))
+            {
+                this->uc_Canon[i] = this->uc_Canon[k];
+                break;
+            }
+        }
+    }
+
+    //Start a fresh search. Marks left over from older searches no longer count.
+    if(++this->ui_Search == 0)
+    {
+        memset(this->ui_Seen, 0, sizeof(this->ui_Seen));
+        memset(this->ui_Placed, 0, sizeof(this->ui_Placed));
+        this->ui_Search = 1;
+    }
+    this->i_Head = 0;
+    this->i_Tail = 0;
+
+    if(!this->fits(c_Shapes.shape[type][(int)o], x, y))
+    {
+        //The pentomino doesn't even fit where it starts.
+        return 0;
+    }
+    this->visit(-1, x, y, o, MOVE_NULL);
+
+    while(this->i_Head < this->i_Tail)
+    {
+        //Decode the next state.
+        int s = this->us_Queue[this->i_Head++];
+        int sy = s%MOVEGEN_Y - UTIL_GRID_CEILING - MOVEGEN_MARGIN;
+        int sx = (s/MOVEGEN_Y)%MOVEGEN_X - MOVEGEN_MARGIN;
+        char so = s/(MOVEGEN_X*MOVEGEN_Y);
+        const PENTOMINO_SHAPE& sh = c_Shapes.shape[type][(int)so];
+
+        //Shifts.
+        if(this->fits(sh, sx-1, sy))
+        {
+            this->visit(s, sx-1, sy, so, MOVE_LEFT);
+        }
+        if(this->fits(sh, sx+1, sy))
+        {
+            this->visit(s, sx+1, sy, so, MOVE_RIGHT);
+        }
+
+        //Rotations, taking the first kickoff that fits just like the board does. X pentominoes never change.
+        if(type != PENTOMINO_X)
+        {
+            for(int r = 0; r < 2; r++)
+            {
+                char rf = (so + (r == 0 ? 1 : 3))%4;
+                const PENTOMINO_SHAPE& rs = c_Shapes.shape[type][(int)rf];
+                const PENTOMINO_KICK* kick = c_Kicks.kick[type][(int)so][(int)rf];
+                for(int k = 0; k < PENTOMINO_KICKS; k++)
+                {
+                    if(this->fits(rs, sx+kick[k].x, sy+kick[k].y))
+                    {
+                        this->visit(s, sx+kick[k].x, sy+kick[k].y, rf, r == 0 ? MOVE_CW : MOVE_CCW);
+                        break;
+                    }
+                }
+            }
+        }
+
+        //Drops.
+        if(this->fits(sh, sx, sy+1))
+        {
+            this->visit(s, sx, sy+1, so, MOVE_DOWN);
+
+            //A hard drop locks, so where it lands is only ever a placement, never searched on from.
+            //Soft drops reach the same state to search tucks from. A state reached by a soft drop
+            // lands in the same place as the state above it, which has already been dropped.
+            if(this->uc_Move[s] != MOVE_DOWN)
+            {
+                int d = 2;
+                while(this->fits(sh, sx, sy+d))
+                {
+                    d++;
+                }
+                this->place(s, sx, sy+d-1, so);
+            }
+        }
+        else
+        {
+            //Grounded. Hard dropping here doesn't move it.
+            this->place(s, sx, sy, so);
+        }
+    }
+
+    return this->i_Count;
+}
+
+//Writes the inputs that reach placement i.
+int MoveGen::getPath(int i, unsigned char* path)
+{
+    //Walk back up to the starting state, then put the inputs in order.
+    int n = 0;
+    for(int s = this->m_Placements[i].state; this->uc_Move[s] != MOVE_NULL; s = this->us_Parent[s])
+    {
+        path[n++] = this->uc_Move[s];
+    }
+    for(int k = 0; k < n/2; k++)
+    {
+        unsigned char t = path[k];
+        path[k] = path[n-1-k];
+        path[n-1-k] = t;
+    }
+
+    //Every path locks with a hard drop, and only the last input is one.
+    path[n++] = MOVE_DROP;
+
+    return n;
+}
+
+//Writes the rows as they would be after locking placement i.
+int MoveGen::result(int i, unsigned int* rows)
+{
+    const MOVEGEN_PLACEMENT& m = this->getPlacement(i);
+    const PENTOMINO_SHAPE& s = c_Shapes.shape[this->uc_Type][(int)m.o];
+    memcpy(rows, this->ui_Rows, sizeof(this->ui_Rows));
+    for(int k = 0; k < 5; k++)
+    {
+        rows[m.y+s.y[k]+UTIL_GRID_CEILING] |= 1u << (m.x+s.x[k]);
+    }
+
+    //Same compaction as the board. Only visible rows can be cleared.
+    int l = 0;
+    int w = UTIL_GRID_ROWS-1;
+    for(int r = UTIL_GRID_ROWS-1; r >= 0; r--)
+    {
+        if(r >= UTIL_GRID_CEILING && rows[r] == UTIL_GRID_FULL_ROW)
+        {
+            l++;
+            continue;
+        }
+        rows[w--] = rows[r];
+    }
+    for(; w >= 0; w--)
+    {
+        rows[w] = 0;
+    }
+
+    return l;
+}
+
+//Replays the inputs of placement i on the board, hard drop included.
+bool MoveGen::play(Board* b, int i)
+{
+    unsigned char path[MOVEGEN_MAX_PATH];
+    int n = this->getPath(i, path);
+
+    for(int k = 0; k < n; k++)
+    {
+        switch(path[k])
+        {
+            case MOVE_LEFT:     b->moveLeft();      break;
+            case MOVE_RIGHT:    b->moveRight();     break;
+            case MOVE_CW:       b->rotateRight();   break;
+            case MOVE_CCW:      b->rotateLeft();    break;
+            case MOVE_DOWN:     b->softDrop();      break;
+            case MOVE_DROP:     b->hardDrop();      break;
+            default:            break;
+        }
+    }
+
+    Pentomino* p = b->getCurrentPentomino();
+    const MOVEGEN_PLACEMENT& m = this->getPlacement(i);
+    return p->getX() == m.x && p->getY() == m.y && this->uc_Canon[p->getOrientation()%4] == this->uc_Canon[(int)m.o];
+}
+
+
+//Queues a state if it hasn't been seen this search.
+void MoveGen::visit(int from, int x, int y, char o, unsigned char move)
+{
+    int s = this->index(x, y, o);
+    if(this->ui_Seen[s] == this->ui_Search)
+    {
+        return;
+    }
+
+    this->ui_Seen[s] = this->ui_Search;
+    this->us_Parent[s] = from;
+    this->uc_Move[s] = move;
+    this->us_Queue[this->i_Tail++] = s;
+}
+
+//Records a placement hard dropped from a state, unless the same cells have been placed already.
+void MoveGen::place(int from, int x, int y, char o)
+{
+    const PENTOMINO_SHAPE& sh = c_Shapes.shape[this->uc_Type][(int)o];
+    int c = this->index(x+sh.left, y+sh.top, this->uc_Canon[(int)o]);
+    if(this->ui_Placed[c] == this->ui_Search)
+    {
+        return;
+    }
+
+    this->ui_Placed[c] = this->ui_Search;
+    MOVEGEN_PLACEMENT& m = this->m_Placements[this->i_Count++];
+    m.x = x;
+    m.y = y;
+    m.o = o;
+    m.state = from;
+}
+
+//Same test as the board, against the copied rows.
+bool MoveGen::fits(const PENTOMINO_SHAPE& s, int x, int y)
+{
+    if(x+s.left < 0 || x+s.right >= UTIL_GRID_WIDTH || y+s.top < -UTIL_GRID_CEILING || y+s.bottom >= UTIL_GRID_HEIGHT)
+    {
+        return false;   //Out of bounds.
+    }
+
+    //One AND per row covered by the shape.
+    for(int r = 0; r <= s.bottom-s.top; r++)
+    {
+        if(this->ui_Rows[y+s.top+r+UTIL_GRID_CEILING] & (s.mask[r] << (x+s.left)))
+        {
+            return false;   //Dead block in the way.
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,99 @@
+/*
+
+    ===================
+    ===== MOVEGEN =====
+    ===================
+
+    Lists every place the current pentomino can lock.
+    A breadth-first search over origin and orientation, using the same
+     moves, rotations and kickoffs as the board, plus soft drops so that
+     tucks under overhangs are found too. A hard drop locks the pentomino
+     in the game, so it only ever ends a path; every path can be played
+     on the board as is.
+    The search works on a copy of the board's rows and never touches the
+     board itself. Placements that cover the same cells (X, I, and any
+     other symmetric orientations) are only listed once, each with the
+     shortest sequence of inputs that reaches it.
+
+*/
+
+#include <cstring>
+
+#include <utilities.h>
+#include <pentomino.h>
+#include <board.h>
+
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+enum e_Move
+{
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    MOVE_CW,
+    MOVE_CCW,
+    MOVE_DOWN,      //Soft drop one row.
+    MOVE_DROP,      //Hard drop. Always the last input of a path.
+    MOVE_NULL = 99
+};
+
+#define MOVEGEN_MARGIN          4                                               //No block is further than this from its pentomino's origin.
+#define MOVEGEN_X               (UTIL_GRID_WIDTH+2*MOVEGEN_MARGIN)              //Number of possible origin columns.
+#define MOVEGEN_Y               (UTIL_GRID_ROWS+2*MOVEGEN_MARGIN)               //Number of possible origin rows.
+#define MOVEGEN_STATES          (4*MOVEGEN_X*MOVEGEN_Y)                         //Number of possible origins in every orientation.
+#define MOVEGEN_MAX_PATH        (MOVEGEN_STATES+1)                              //Longest possible path, hard drop included.
+
+struct MOVEGEN_PLACEMENT
+{
+    signed char     x, y;   //Origin of the pentomino once locked.
+    char            o;      //Orientation once locked.
+    unsigned short  state;  //Search state the placement is hard dropped from, for rebuilding its path.
+};
+
+
+class MoveGen
+{
+    public:
+    MoveGen();      //Constructor
+    ~MoveGen();     //Destructor
+
+    int generate(Board* b);                                         //Finds every placement of the board's current pentomino. Returns the number found.
+    int generate(Board* b, unsigned char type, int x, int y, char o);   //Finds every placement of a pentomino starting from any origin and orientation.
+    int generate(const unsigned int* rows, unsigned char type, int x, int y, char o);   //Same, against bare row masks laid out like the board's, hidden rows first.
+    int getPath(int i, unsigned char* path);                        //Writes the inputs that reach placement i. Returns the number of inputs.
+    int  result(int i, unsigned int* rows);                         //Writes the rows as they would be after locking placement i. Returns the number of lines cleared.
+    bool play(Board* b, int i);                                     //Replays the inputs of placement i on the board, hard drop included. True if it arrived. Locking is left to the caller.
+
+
+    //Gets
+    int                         getCount()                  {return this->i_Count;}
+    const MOVEGEN_PLACEMENT&    getPlacement(int i)         {return this->m_Placements[i];}
+
+
+    private:
+    bool fits(const PENTOMINO_SHAPE& s, int x, int y);              //Same test as the board, against the copied rows.
+    int  index(int x, int y, char o)    {return (o*MOVEGEN_X + x+MOVEGEN_MARGIN)*MOVEGEN_Y + y+UTIL_GRID_CEILING+MOVEGEN_MARGIN;}
+    void visit(int from, int x, int y, char o, unsigned char move); //Queues a state if it hasn't been seen this search.
+    void place(int from, int x, int y, char o);                     //Records a placement hard dropped from a state, unless its cells have been placed this search.
+    int  search(unsigned char type, int x, int y, char o);          //Runs the search against the copied rows.
+
+
+    //Variables
+    unsigned int        ui_Rows[UTIL_GRID_ROWS]             ;   //Copy of the board's rows.
+    unsigned char       uc_Type                             ;   //Pentomino being placed.
+    unsigned char       uc_Canon[4]                         ;   //First orientation with the same cells as each orientation.
+
+    unsigned int        ui_Search                   = 0     ;   //Number of the current search. Marks which states have been seen.
+    unsigned int        ui_Seen[MOVEGEN_STATES]             ;   //Search each state was last seen in.
+    unsigned int        ui_Placed[MOVEGEN_STATES]           ;   //Search each set of cells was last placed in.
+    unsigned short      us_Parent[MOVEGEN_STATES]           ;   //State each state was first reached from.
+    unsigned char       uc_Move[MOVEGEN_STATES]             ;   //Input that first reached each state.
+    unsigned short      us_Queue[MOVEGEN_STATES]            ;   //States waiting to be searched.
+    int                 i_Head                      = 0     ;   //Next state to search.
+    int                 i_Tail                      = 0     ;   //End of the queue.
+
+    MOVEGEN_PLACEMENT   m_Placements[MOVEGEN_STATES]        ;   //Every placement found.
+    int                 i_Count                     = 0     ;   //Number of placements found.
+};
+
+#endif //MOVEGEN_H
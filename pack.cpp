@@ -0,0 +1,142 @@
+#include "pack.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static_assert(PACK_ALIGN % 4096 == 0, "Entries must start on a page boundary to be shared between processes.");
+
+//Reads a little endian word.
+static unsigned int read32(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+Pack::Pack()
+{
+}
+
+Pack::~Pack()
+{
+    this->close();
+}
+
+
+//Maps an archive and reads its entries.
+bool Pack::open(const char* path)
+{
+    this->close();
+
+    //Map the whole file read only. The mapping outlives the file handle.
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(f == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE m = nullptr;
+    if(GetFileSizeEx(f, &size) && size.QuadPart >= PACK_HEADER_SIZE)
+    {
+        m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(f);
+    if(!m)
+    {
+        return false;
+    }
+    this->uc_Data = (const unsigned char*)MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if(!this->uc_Data)
+    {
+        CloseHandle(m);
+        return false;
+    }
+    this->p_Map = m;
+    this->sz_Size = size.QuadPart;
+#else
+    int f = ::open(path, O_RDONLY);
+    if(f < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    void* data = MAP_FAILED;
+    if(fstat(f, &st) == 0 && st.st_size >= PACK_HEADER_SIZE)
+    {
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, f, 0);
+    }
+    ::close(f);
+    if(data == MAP_FAILED)
+    {
+        return false;
+    }
+    this->uc_Data = (const unsigned char*)data;
+    this->sz_Size = st.st_size;
+#endif
+
+    //Header.
+    const unsigned char* h = this->uc_Data;
+    unsigned int count = read32(h+8);
+    if(memcmp(h, "PNTP", 4) != 0 || h[4] != PACK_VERSION || count > (this->sz_Size - PACK_HEADER_SIZE)/PACK_ENTRY_SIZE)
+    {
+        this->close();
+        return false;
+    }
+
+    //Entries. Each one's data has to lie inside the file.
+    this->v_Entries.resize(count);
+    for(unsigned int i = 0; i < count; i++)
+    {
+        const unsigned char* p = h + PACK_HEADER_SIZE + i*PACK_ENTRY_SIZE;
+        PACK_ENTRY& e = this->v_Entries[i];
+        memcpy(e.name, p, PACK_NAME);
+        e.name[PACK_NAME-1] = 0;
+        e.offset = read32(p+32);
+        e.size = read32(p+36);
+        e.rate = read32(p+40);
+        e.channels = p[44];
+        e.bits = p[45];
+        if(e.offset > this->sz_Size || e.size > this->sz_Size - e.offset)
+        {
+            this->close();
+            return false;
+        }
+    }
+    return true;
+}
+
+//Unmaps the archive.
+void Pack::close()
+{
+    if(this->uc_Data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(this->uc_Data);
+        CloseHandle(this->p_Map);
+#else
+        munmap((void*)this->uc_Data, this->sz_Size);
+#endif
+    }
+    this->uc_Data = nullptr;
+    this->sz_Size = 0;
+    this->p_Map = nullptr;
+    this->v_Entries.clear();
+}
+
+//Finds an entry by name.
+const PACK_ENTRY* Pack::find(const char* name)
+{
+    for(unsigned int i = 0; i < this->v_Entries.size(); i++)
+    {
+        if(strcmp(this->v_Entries[i].name, name) == 0)
+        {
+            return &this->v_Entries[i];
+        }
+    }
+    return nullptr;
+}
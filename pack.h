@@ -0,0 +1,84 @@
+/*
+
+    ================
+    ===== PACK =====
+    ================
+
+    An archive of assets, mapped straight into memory instead of read.
+    Every entry starts on a page boundary, so whatever is made from it
+     can point into the mapping rather than copy out of it, and several
+     games running at once share the same pages.
+    Short sound effects are stored already decoded, as raw PCM with the
+     format needed to play it. Anything else is stored as is.
+    Archives are built by pentris-pack.
+
+    File layout, all little endian:
+        4 bytes     "PNTP"
+        1 byte      Version
+        3 bytes     Padding
+        4 bytes     Number of entries
+        4 bytes     Padding
+        48 bytes    Each entry:
+            32 bytes    Name, zero padded
+            4 bytes     Offset of its data from the start of the file, a multiple of PACK_ALIGN
+            4 bytes     Size of its data
+            4 bytes     Sample rate of decoded PCM, or 0 if stored as is
+            1 byte      Channels of decoded PCM
+            1 byte      Bits per sample of decoded PCM: 8 unsigned, or 16 signed
+            2 bytes     Padding
+        ...         Data of each entry
+
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifndef PACK_H
+#define PACK_H
+
+#define PACK_VERSION            1                                       //Current file version.
+#define PACK_ALIGN              4096                                    //Every entry's data starts on a multiple of this. At least a page.
+#define PACK_NAME               32                                      //Bytes kept for each entry's name, including the terminator.
+#define PACK_HEADER_SIZE        16                                      //Bytes before the first entry.
+#define PACK_ENTRY_SIZE         48                                      //Bytes of each entry.
+
+
+//One file in an archive.
+struct PACK_ENTRY
+{
+    char            name[PACK_NAME]     ;           //File name it was packed from, without any directory.
+    unsigned int    offset              = 0;        //Where its data starts.
+    unsigned int    size                = 0;        //How long its data is.
+    unsigned int    rate                = 0;        //Sample rate of decoded PCM, or 0 if stored as is.
+    unsigned char   channels            = 0;        //Channels of decoded PCM.
+    unsigned char   bits                = 0;        //Bits per sample of decoded PCM.
+};
+
+
+class Pack
+{
+    public:
+    Pack();         //Constructor
+    ~Pack();        //Destructor. Unmaps the archive; nothing made from it can be used after.
+
+    bool open(const char* path);                    //Maps an archive and reads its entries. False if it can't be mapped or isn't an archive.
+    void close();                                   //Unmaps the archive.
+    const PACK_ENTRY* find(const char* name);       //Finds an entry by name. nullptr if there isn't one, or nothing is open.
+
+
+    //Gets
+    bool                    getOpen()                       {return this->uc_Data != nullptr;}
+    unsigned int            getCount()                      {return this->v_Entries.size();}
+    const PACK_ENTRY&       getEntry(unsigned int i)        {return this->v_Entries[i];}
+    const unsigned char*    getData(const PACK_ENTRY* e)    {return this->uc_Data + e->offset;}
+
+
+    private:
+    const unsigned char*        uc_Data             = nullptr;      //The whole archive, mapped.
+    size_t                      sz_Size             = 0;            //Size of the mapping.
+    void*                       p_Map               = nullptr;      //Handle keeping the mapping alive, where the system needs one.
+    std::vector<PACK_ENTRY>     v_Entries           ;               //Every entry, in file order.
+};
+
+#endif //PACK_H
@@ -0,0 +1,199 @@
+/*
+
+    ==================
+    ===== PACKER =====
+    ==================
+
+    Builds an archive the game can map straight into memory.
+    Each file is stored under its name, without any directory. PCM WAV
+     files are decoded on the way in, so the game plays them without
+     decoding them again. Anything else, like music and fonts, is stored
+     as is.
+
+    Usage:
+        pentris-pack <archive> <file>...    Packs every file into <archive>, replacing it.
+
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <pack.h>
+
+//Writes a little endian word.
+static void write32(unsigned char* p, unsigned int ui)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        p[i] = ui >> (8*i);
+    }
+}
+
+//Reads a little endian word.
+static unsigned int read32(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+//Reads a whole file. False if it can't be read.
+static bool slurp(const char* path, std::vector<unsigned char>& data)
+{
+    FILE* f = fopen(path, "rb");
+    if(!f)
+    {
+        return false;
+    }
+    data.clear();
+    unsigned char buffer[65536];
+    size_t n;
+    while((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer+n);
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+//Finds the PCM in a WAV file, and its format. False if it isn't plain 8 or 16 bit PCM, in mono or stereo.
+static bool decode(const std::vector<unsigned char>& wav, PACK_ENTRY& e, size_t& start)
+{
+    if(wav.size() < 12 || memcmp(&wav[0], "RIFF", 4) != 0 || memcmp(&wav[8], "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    //Walk the chunks for the format and the samples. Chunks are padded to an even size.
+    bool format = false;
+    for(size_t p = 12; p + 8 <= wav.size(); )
+    {
+        unsigned int size = read32(&wav[p+4]);
+        const unsigned char* c = wav.data() + p+8;
+        if(size > wav.size() - p - 8)
+        {
+            return false;
+        }
+        if(memcmp(&wav[p], "fmt ", 4) == 0 && size >= 16)
+        {
+            unsigned int tag = c[0] | (c[1] << 8);
+            e.channels = c[2];
+            e.rate = read32(c+4);
+            e.bits = c[14];
+            format = tag == 1 && (e.channels == 1 || e.channels == 2) && (e.bits == 8 || e.bits == 16) && e.rate;
+        }
+        if(memcmp(&wav[p], "data", 4) == 0 && format)
+        {
+            start = p+8;
+            e.size = size - size % (e.channels*e.bits/8);
+            return true;
+        }
+        p += 8 + size + (size & 1);
+    }
+    return false;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc < 3)
+    {
+        fprintf(stderr, "usage: %s <archive> <file>...\n", argv[0]);
+        return 2;
+    }
+
+    //Read every file in, decoding what can be, and lay the data out page by page after the entries.
+    unsigned int count = argc-2;
+    std::vector<PACK_ENTRY> entries(count);
+    std::vector<std::vector<unsigned char>> files(count);
+    std::vector<size_t> starts(count, 0);
+    size_t offset = PACK_HEADER_SIZE + count*PACK_ENTRY_SIZE;
+    for(unsigned int i = 0; i < count; i++)
+    {
+        const char* path = argv[2+i];
+        const char* name = path;
+        for(const char* c = path; *c; c++)
+        {
+            if(*c == '/' || *c == '\\')
+            {
+                name = c+1;
+            }
+        }
+        if(strlen(name) >= PACK_NAME)
+        {
+            fprintf(stderr, "name too long: %s\n", name);
+            return 1;
+        }
+        if(!slurp(path, files[i]))
+        {
+            fprintf(stderr, "cannot read %s\n", path);
+            return 1;
+        }
+
+        PACK_ENTRY& e = entries[i];
+        memset(e.name, 0, PACK_NAME);
+        strcpy(e.name, name);
+        if(!decode(files[i], e, starts[i]))
+        {
+            e.rate = e.channels = e.bits = 0;
+            e.size = files[i].size();
+            starts[i] = 0;
+        }
+
+        offset = (offset + PACK_ALIGN-1) / PACK_ALIGN * PACK_ALIGN;
+        if(offset + e.size > 0xFFFFFFFFu)
+        {
+            fprintf(stderr, "archive too large at %s\n", path);
+            return 1;
+        }
+        e.offset = offset;
+        offset += e.size;
+
+        if(e.rate)
+        {
+            printf("%-32s %10u bytes  PCM %u Hz, %u channel, %u bit\n", e.name, e.size, e.rate, e.channels, e.bits);
+        }
+        else
+        {
+            printf("%-32s %10u bytes  as is\n", e.name, e.size);
+        }
+    }
+
+    //Header and entries, then every entry's data on its boundary.
+    std::vector<unsigned char> out(offset, 0);
+    memcpy(&out[0], "PNTP", 4);
+    out[4] = PACK_VERSION;
+    write32(&out[8], count);
+    for(unsigned int i = 0; i < count; i++)
+    {
+        const PACK_ENTRY& e = entries[i];
+        unsigned char* p = &out[PACK_HEADER_SIZE + i*PACK_ENTRY_SIZE];
+        memcpy(p, e.name, PACK_NAME);
+        write32(p+32, e.offset);
+        write32(p+36, e.size);
+        write32(p+40, e.rate);
+        p[44] = e.channels;
+        p[45] = e.bits;
+        if(e.size)
+        {
+            memcpy(&out[e.offset], &files[i][starts[i]], e.size);
+        }
+    }
+
+    FILE* f = fopen(argv[1], "wb");
+    if(!f)
+    {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    bool ok = fwrite(&out[0], 1, out.size(), f) == out.size();
+    ok = fclose(f) == 0 && ok;
+    if(!ok)
+    {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    printf("%u files, %lu bytes\n", count, (unsigned long)out.size());
+    return 0;
+}
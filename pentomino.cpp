@@ -1,59 +1,94 @@
-#include "pentomino.h"
-
-Pentomino::Pentomino(unsigned char uc_type)
-{
-    //Randomly decide the configuration.
-    //TODO: Optimize randomization and fairness.
-    srand(time(nullptr));
-    this->setType(uc_type);
-
-    ALLEGRO_COLOR clr = al_map_rgb( m_Tint[this->getType()].uc_Red,
-                                    m_Tint[this->getType()].uc_Green,
-                                    m_Tint[this->getType()].uc_Blue);
-
-    //Add the blocks to the pentomino.
-    for(int i = 0; i < this->uc_N; i++)
-    {
-        this->b_Blocks.insert(this->b_Blocks.begin()+i, new Block(clr));
-    }
-
-    //Lookup initial positions of each block.
-    std::pair<std::multimap<unsigned char, PENTOMINO_INITIAL_POSITION>::iterator, std::multimap<unsigned char, PENTOMINO_INITIAL_POSITION>::iterator>
-        it = m_InitialPosition.equal_range(this->getType());
-
-    //Actually place the blocks on the board.
-    for(std::multimap<unsigned char, PENTOMINO_INITIAL_POSITION>::iterator i = it.first; i != it.second; ++i)
-    {
-        this->b_Blocks.at(i->second.n)->setX(UTIL_INITIAL_X + i->second.x);
-        this->b_Blocks.at(i->second.n)->setY(UTIL_INITIAL_Y + i->second.y);
-
-        //Also record the rotation data.
-        this->b_Blocks.at(i->second.n)->setDx(i->second.dx);
-        this->b_Blocks.at(i->second.n)->setDy(i->second.dy);
-    }
-}
-
-Pentomino::~Pentomino()
-{
-    //Flag each of these pentomino's blocks to dead blocks.
-    for (int i = 0; i < this->uc_N; i++)
-    {
-        this->getBlock(i)->setLiveSwitch(false);
-    }
-}
-
-
-//Pull data off the kickoff table.
-std::pair<int,int> Pentomino::pullKickoffData(int i, int ri, int rf)
-{
-    PENTOMINO_KICKOFF it = m_Kickoffs[std::make_pair(this->getType(),std::make_pair(ri,rf))];
-    switch(i)
-    {
-        case 1:     return std::make_pair(it.kx1,it.ky1);
-        case 2:     return std::make_pair(it.kx2,it.ky2);
-        case 3:     return std::make_pair(it.kx3,it.ky3);
-        case 4:     return std::make_pair(it.kx4,it.ky4);
-        default:    break;
-    }
-    return std::make_pair(0,0);
-}
+#include "pentomino.h"
+
+//Sanity checks on the orientation table. A bad entry here fails the build instead of the game.
+constexpr bool checkShapes()
+{
+    for(int p = 0; p < PENTOMINO_TYPES; p++)
+    {
+        for(int o = 0; o < 4; o++)
+        {
+            const PENTOMINO_SHAPE& s = c_Shapes.shape[p][o];
+            int n = 0;
+            for(int r = 0; r < 5; r++)
+            {
+                for(unsigned int m = s.mask[r]; m; m &= m-1)
+                {
+                    n++;
+                }
+            }
+            if(n != 5)
+            {
+                return false;   //Two blocks share a cell.
+            }
+            if(s.bottom-s.top > 4 || s.right-s.left > 4)
+            {
+                return false;   //Too large to be a pentomino.
+            }
+        }
+    }
+    return true;
+}
+
+//Spawn must be in bounds.
+constexpr bool checkSpawns()
+{
+    for(int p = 0; p < PENTOMINO_TYPES; p++)
+    {
+        const PENTOMINO_SHAPE& s = c_Shapes.shape[p][0];
+        if(UTIL_INITIAL_X+s.left < 0 || UTIL_INITIAL_X+s.right >= UTIL_GRID_WIDTH || UTIL_INITIAL_Y+s.top < -UTIL_GRID_CEILING)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//X pentominoes look the same in every orientation.
+constexpr bool checkX()
+{
+    for(int o = 1; o < 4; o++)
+    {
+        for(int r = 0; r < 5; r++)
+        {
+            if(c_Shapes.shape[PENTOMINO_X][o].mask[r] != c_Shapes.shape[PENTOMINO_X][0].mask[r])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//Every quarter turn of every pentomino has its own kickoffs, and nothing else does.
+constexpr bool checkKicks()
+{
+    for(int p = 0; p < PENTOMINO_TYPES; p++)
+    {
+        for(int ri = 0; ri < 4; ri++)
+        {
+            for(int rf = 0; rf < 4; rf++)
+            {
+                const PENTOMINO_KICK* c = c_Kicks.kick[p][ri][rf];
+                bool turn = (rf == (ri+1)%4 || rf == (ri+3)%4);
+                if(c[0].x != 0 || c[0].y != 0 || turn != (c[1].x != 0 || c[1].y != 0))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return sizeof(c_KickoffList)/sizeof(c_KickoffList[0]) == PENTOMINO_TYPES*8;
+}
+
+static_assert(checkShapes(), "Every orientation of every pentomino must be exactly 5 distinct blocks.");
+static_assert(checkSpawns(), "Every pentomino must spawn inside the board.");
+static_assert(checkX(), "X pentominoes must not change when rotated.");
+static_assert(checkKicks(), "Every quarter turn of every pentomino needs exactly one row of kickoffs.");
+
+
+Pentomino::Pentomino(unsigned char uc_type)
+{
+    //The shape is looked up from the table; only the origin and orientation need to be stored.
+    this->setType(uc_type);
+}
+
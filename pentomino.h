@@ -1,414 +1,556 @@
-
-/*
-
-    =====================
-    ===== PENTOMINO =====
-    =====================
-
-    A group of exactly 5 blocks.
-    Each one falls through the board at a set speed.
-    There are 18 different configurations:
-    C, F, H, I, J, K, L, N, P, Q, S, T, U, V, W, X, Y, and Z.
-
-    Specifically, this is a vector of pointers to blocks.
-    The blocks actually belong to the board itself, or at least
-     they ultimately will.
-    This class will easily access things like where the current
-     pentomino is, its orientation and configuration, etc.
-
-*/
-
-#include <vector>
-#include <map>
-#include <iostream>
-#include <iterator>
-
-#include <allegro5/allegro.h>
-#include <allegro5/allegro_image.h>
-
-#include <utilities.h>
-#include <block.h>
-
-#ifndef PENTOMINO_H
-#define PENTOMINO_H
-
-enum e_Name
-{
-    PENTOMINO_C,
-    PENTOMINO_D,
-    PENTOMINO_F,
-    PENTOMINO_I,
-    PENTOMINO_J,
-    PENTOMINO_K,
-    PENTOMINO_L,
-    PENTOMINO_N,
-    PENTOMINO_P,
-    PENTOMINO_Q,
-    PENTOMINO_S,
-    PENTOMINO_T,
-    PENTOMINO_U,
-    PENTOMINO_V,
-    PENTOMINO_W,
-    PENTOMINO_X,
-    PENTOMINO_Y,
-    PENTOMINO_Z,
-    PENTOMINO_NULL = 99
-};
-
-struct PENTOMINO_TINT
-{
-    unsigned char uc_Red;
-    unsigned char uc_Green;
-    unsigned char uc_Blue;
-};
-
-//Color scheme of each pentomino based on its configuration.
-static std::map<unsigned char, PENTOMINO_TINT> m_Tint = {
-    {PENTOMINO_C, {85,43,0}},
-    {PENTOMINO_D, {170,85,255}},
-    {PENTOMINO_F, {0,85,0}},
-    {PENTOMINO_I, {85,255,170}},
-    {PENTOMINO_J, {0,0,255}},
-    {PENTOMINO_K, {85,0,0}},
-    {PENTOMINO_L, {255,128,0}},
-    {PENTOMINO_N, {255,0,0}},
-    {PENTOMINO_P, {255,255,0}},
-    {PENTOMINO_Q, {170,170,0}},
-    {PENTOMINO_S, {0,128,255}},
-    {PENTOMINO_T, {128,0,255}},
-    {PENTOMINO_U, {0,255,0}},
-    {PENTOMINO_V, {0,255,255}},
-    {PENTOMINO_W, {255,0,128}},
-    {PENTOMINO_X, {43,0,85}},
-    {PENTOMINO_Y, {255,128,255}},
-    {PENTOMINO_Z, {255,170,85}},
-    {PENTOMINO_NULL,{30,30,30}}
-};
-
-struct PENTOMINO_INITIAL_POSITION
-{
-    int n;  //Block of the pentomino.
-    int x;  //That block's initial x.
-    int y;  //That block's initial y.
-    int dx; //Horizontal movement on counterclockwise rotation.
-    int dy; //Vertical movement on counterclockwise rotation.
-};
-
-//Initial position of each block of each type of pentomino. Initial orientation is always horizontal, flat side down.
-static std::multimap<unsigned char, PENTOMINO_INITIAL_POSITION> m_InitialPosition = {
-    {PENTOMINO_C, {0,0,0,  1, 1} }, //
-    {PENTOMINO_C, {1,0,1,  2, 0} }, //   __    __
-    {PENTOMINO_C, {2,1,1,  1,-1} }, //  |__|__|__|
-    {PENTOMINO_C, {3,2,1,  0,-2} }, //  |__|__|__|
-    {PENTOMINO_C, {4,2,0, -1,-1} }, //
-
-    {PENTOMINO_D, {0,1,0,  0, 1} }, //  Because D sounds like T.
-    {PENTOMINO_D, {1,0,1,  2, 1} }, //      __
-    {PENTOMINO_D, {2,1,1,  1, 0} }, //   __|__|__ __
-    {PENTOMINO_D, {3,2,1,  0,-1} }, //  |__|__|__|__|
-    {PENTOMINO_D, {4,3,1, -1,-2} }, //
-
-    {PENTOMINO_F, {0,1,0, -1, 1} }, //      __
-    {PENTOMINO_F, {1,1,1,  0, 0} }, //     |__|__
-    {PENTOMINO_F, {2,2,1, -1,-1} }, //   __|__|__|
-    {PENTOMINO_F, {3,1,2,  1,-1} }, //  |__|__|
-    {PENTOMINO_F, {4,0,2,  2, 0} }, //
-
-    {PENTOMINO_I, {0,0,0,  2, 2} }, //
-    {PENTOMINO_I, {1,1,0,  1, 1} }, //   __ __ __ __ __
-    {PENTOMINO_I, {2,2,0,  0, 0} }, //  |__|__|__|__|__|
-    {PENTOMINO_I, {3,3,0, -1,-1} }, //
-    {PENTOMINO_I, {4,4,0, -2,-2} }, //
-
-    {PENTOMINO_J, {0,0,0,  1, 2} }, //
-    {PENTOMINO_J, {1,0,1,  2, 1} }, //   __
-    {PENTOMINO_J, {2,1,1,  1, 0} }, //  |__|__ __ __
-    {PENTOMINO_J, {3,2,1,  0,-1} }, //  |__|__|__|__|
-    {PENTOMINO_J, {4,3,1, -1,-2} }, //
-
-    {PENTOMINO_K, {0,1,0, -1, 1} }, //      __
-    {PENTOMINO_K, {1,0,1,  1, 1} }, //   __|__|
-    {PENTOMINO_K, {2,1,1,  0, 0} }, //  |__|__|__
-    {PENTOMINO_K, {3,1,2,  1,-1} }, //     |__|__|
-    {PENTOMINO_K, {4,2,2,  0,-2} }, //
-
-    {PENTOMINO_L, {0,3,0, -2,-1} }, //
-    {PENTOMINO_L, {1,0,1,  2, 1} }, //            __
-    {PENTOMINO_L, {2,1,1,  1, 0} }, //   __ __ __|__|
-    {PENTOMINO_L, {3,2,1,  0,-1} }, //  |__|__|__|__|
-    {PENTOMINO_L, {4,3,1, -1,-2} }, //
-
-    {PENTOMINO_N, {0,0,0,  1, 2} }, //
-    {PENTOMINO_N, {1,1,0,  0, 1} }, //   __ __
-    {PENTOMINO_N, {2,1,1,  1, 0} }, //  |__|__|__ __
-    {PENTOMINO_N, {3,2,1,  0,-1} }, //     |__|__|__|
-    {PENTOMINO_N, {4,3,1, -1,-2} }, //
-
-    {PENTOMINO_P, {0,0,0,  1, 1} }, //
-    {PENTOMINO_P, {1,1,0,  0, 0} }, //   __ __
-    {PENTOMINO_P, {2,0,1,  2, 0} }, //  |__|__|__
-    {PENTOMINO_P, {3,1,1,  1,-1} }, //  |__|__|__|
-    {PENTOMINO_P, {4,2,1,  0,-2} }, //
-
-    {PENTOMINO_Q, {0,1,0,  0, 0} }, //
-    {PENTOMINO_Q, {1,2,0, -1,-1} }, //      __ __
-    {PENTOMINO_Q, {2,0,1,  2, 0} }, //   __|__|__|
-    {PENTOMINO_Q, {3,1,1,  1,-1} }, //  |__|__|__|
-    {PENTOMINO_Q, {4,2,1,  0,-2} }, //
-
-    {PENTOMINO_S, {0,1,0, -1, 1} }, //      __ __
-    {PENTOMINO_S, {1,2,0, -2, 0} }, //     |__|__|
-    {PENTOMINO_S, {2,1,1,  0, 0} }, //   __|__|
-    {PENTOMINO_S, {3,0,2,  2, 0} }, //  |__|__|
-    {PENTOMINO_S, {4,1,2,  1,-1} }, //
-
-    {PENTOMINO_T, {0,1,0, -1, 1} }, //      __
-    {PENTOMINO_T, {1,1,1,  0, 0} }, //     |__|
-    {PENTOMINO_T, {2,0,2,  2, 0} }, //   __|__|__
-    {PENTOMINO_T, {3,1,2,  1,-1} }, //  |__|__|__|
-    {PENTOMINO_T, {4,2,2,  0,-2} }, //
-
-    {PENTOMINO_U, {0,2,0, -1, 0} }, //  A lowercase U, kind of.
-    {PENTOMINO_U, {1,3,0, -2,-1} }, //         __ __
-    {PENTOMINO_U, {2,0,1,  2, 1} }, //   __ __|__|__|
-    {PENTOMINO_U, {3,1,1,  1, 0} }, //  |__|__|__|
-    {PENTOMINO_U, {4,2,1,  0,-1} }, //
-
-    {PENTOMINO_V, {0,2,0, -2, 0} }, //         __
-    {PENTOMINO_V, {1,2,1, -1,-1} }, //        |__|
-    {PENTOMINO_V, {2,2,2,  0,-2} }, //   __ __|__|
-    {PENTOMINO_V, {3,1,2,  1,-1} }, //  |__|__|__|
-    {PENTOMINO_V, {4,0,2,  2, 0} }, //
-
-    {PENTOMINO_W, {0,0,0,  0, 2} }, //   __
-    {PENTOMINO_W, {1,0,1,  1, 1} }, //  |__|__
-    {PENTOMINO_W, {2,1,1,  0, 0} }, //  |__|__|__
-    {PENTOMINO_W, {3,1,2,  1,-1} }, //     |__|__|
-    {PENTOMINO_W, {4,2,2,  0,-2} }, //
-
-    {PENTOMINO_X, {0,1,0, -1, 1} }, //      __
-    {PENTOMINO_X, {1,0,1,  1, 1} }, //   __|__|__
-    {PENTOMINO_X, {2,1,1,  0, 0} }, //  |__|__|__|
-    {PENTOMINO_X, {3,2,1, -1,-1} }, //     |__|
-    {PENTOMINO_X, {4,1,2,  1,-1} }, //
-
-    {PENTOMINO_Y, {0,2,0, -1, 0} }, //
-    {PENTOMINO_Y, {1,0,1,  2, 1} }, //         __
-    {PENTOMINO_Y, {2,1,1,  1, 0} }, //   __ __|__|__
-    {PENTOMINO_Y, {3,2,1,  0,-1} }, //  |__|__|__|__|
-    {PENTOMINO_Y, {4,3,1, -1,-2} }, //
-
-    {PENTOMINO_Z, {0,0,0,  0, 2} }, //   __ __
-    {PENTOMINO_Z, {1,1,0, -1, 1} }, //  |__|__|
-    {PENTOMINO_Z, {2,1,1,  0, 0} }, //     |__|__
-    {PENTOMINO_Z, {3,1,2,  1,-1} }, //     |__|__|
-    {PENTOMINO_Z, {4,2,2,  0,-2} }  //
-};
-
-struct PENTOMINO_KICKOFF
-{
-    char kx1, ky1;
-    char kx2, ky2;
-    char kx3, ky3;
-    char kx4, ky4;
-};
-
-//Table of kickoff tests based on pentomino configuration, as well as initial and final orientations.
-static std::map<std::pair<char, std::pair<char,char>>, PENTOMINO_KICKOFF> m_Kickoffs = {
-    {{PENTOMINO_C,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_C,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_C,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_C,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_C,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_C,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_C,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_C,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_D,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_D,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_D,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_D,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_D,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_D,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_D,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_D,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_F,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_F,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_F,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_F,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_F,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_F,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_F,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_F,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_I,{0,1}},   {1,-1,   -1, 1,    2,-2,    -2, 2}   },
-    {{PENTOMINO_I,{1,0}},   {1,-1,   -1, 1,    2,-2,    -2, 2}   },
-    {{PENTOMINO_I,{1,2}},   {1, 1,   -1,-1,    2, 2,    -2,-2}   },
-    {{PENTOMINO_I,{2,1}},   {1, 1,   -1,-1,    2, 2,    -2,-2}   },
-    {{PENTOMINO_I,{2,3}},   {1,-1,   -1, 1,    2,-2,    -2, 2}   },
-    {{PENTOMINO_I,{3,2}},   {1,-1,   -1, 1,    2,-2,    -2, 2}   },
-    {{PENTOMINO_I,{3,0}},   {1, 1,   -1,-1,    2, 2,    -2,-2}   },
-    {{PENTOMINO_I,{0,3}},   {1, 1,   -1,-1,    2, 2,    -2,-2}   },
-
-    {{PENTOMINO_J,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_J,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_J,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_J,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_J,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_J,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_J,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_J,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_K,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_K,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_K,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_K,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_K,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_K,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_K,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_K,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_L,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_L,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_L,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_L,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_L,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_L,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_L,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_L,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_N,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_N,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_N,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_N,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_N,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_N,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_N,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_N,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_P,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_P,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_P,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_P,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_P,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_P,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_P,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_P,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_Q,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_Q,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_Q,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_Q,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_Q,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_Q,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_Q,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_Q,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_S,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_S,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_S,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_S,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_S,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_S,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_S,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_S,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_T,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_T,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_T,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_T,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_T,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_T,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_T,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_T,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_U,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_U,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_U,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_U,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_U,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_U,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_U,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_U,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_V,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_V,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_V,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_V,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_V,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_V,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_V,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_V,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_W,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_W,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_W,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_W,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_W,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_W,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_W,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_W,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_X,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_X,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_X,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_X,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_X,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_X,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_X,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_X,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-
-    {{PENTOMINO_Y,{0,1}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_Y,{1,0}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_Y,{1,2}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-    {{PENTOMINO_Y,{2,1}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_Y,{2,3}},   { 2,0,   -1, 0,    2,-1,    -1, 2}   },
-    {{PENTOMINO_Y,{3,2}},   {-2,0,    1, 0,   -2, 1,     1,-2}   },
-    {{PENTOMINO_Y,{3,0}},   { 1,0,   -2, 0,    1, 2,    -2,-1}   },
-    {{PENTOMINO_Y,{0,3}},   {-1,0,    2, 0,   -1,-2,     2, 1}   },
-
-    {{PENTOMINO_Z,{0,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_Z,{1,0}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_Z,{1,2}},   { 1,0,    1, 1,    0,-2,     1,-2}   },
-    {{PENTOMINO_Z,{2,1}},   {-1,0,   -1,-1,    0, 2,    -1, 2}   },
-    {{PENTOMINO_Z,{2,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   },
-    {{PENTOMINO_Z,{3,2}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_Z,{3,0}},   {-1,0,   -1, 1,    0,-2,    -1,-2}   },
-    {{PENTOMINO_Z,{0,3}},   { 1,0,    1,-1,    0, 2,     1, 2}   }
-};
-
-class Pentomino
-{
-    public:
-    Pentomino(unsigned char uc_type);                                   //Constructor
-    ~Pentomino();                                                       //Destructor
-
-    std::pair<int,int>  pullKickoffData(int i, int ri, int rf);         //Pull data off the kickoff table.
-
-
-    //Gets
-    unsigned char   getN()                      {return this->b_Blocks.size();}
-    unsigned char   getType()                   {return this->uc_Type;}
-    char            getOrientation()            {return this->c_Orientation;}
-    Block*          getBlock(unsigned char n)   {return this->b_Blocks.at(n);}
-    int             getShadow()                 {return this->i_Shadow;}
-
-    //Sets
-    void setN(unsigned char uc)                 {this->uc_N = uc;}
-    void setType(unsigned char uc)              {this->uc_Type = uc;}
-    void setOrientation(char c)                 {this->c_Orientation = c;}
-    void setBlock(unsigned char n, Block* b)    {this->b_Blocks.at(n) = b;}
-    void setShadow(int i)                       {this->i_Shadow = i;}
-
-
-    private:
-    unsigned char       uc_N                        = 5;                //Number of blocks (should normally be 5).
-    unsigned char       uc_Type                     = PENTOMINO_NULL;   //Configuration of the pentomino.
-    char                c_Orientation               = 0;                //Orientation (starts at 0). Counts -clockwise- rotations.
-    std::vector<Block*> b_Blocks                    ;                   //The blocks.
-    int                 i_Shadow                    = 0;                //Location of the shadow.
-
-};
-
-#endif //PENTOMINO_H
+
+/*
+
+    =====================
+    ===== PENTOMINO =====
+    =====================
+
+    A group of exactly 5 blocks.
+    Each one falls through the board at a set speed.
+    There are 18 different configurations:
+    C, F, H, I, J, K, L, N, P, Q, S, T, U, V, W, X, Y, and Z.
+
+    Specifically, this is an origin, a configuration, and an
+     orientation. The shape of every configuration in every
+     orientation is worked out at compile time, so a block's
+     position is just the origin plus an offset from the table.
+    Dead blocks belong to the board itself once the pentomino locks.
+
+*/
+
+#include <map>
+#include <iostream>
+#include <iterator>
+
+#include <utilities.h>
+
+#ifndef PENTOMINO_H
+#define PENTOMINO_H
+
+enum e_Name
+{
+    PENTOMINO_C,
+    PENTOMINO_D,
+    PENTOMINO_F,
+    PENTOMINO_I,
+    PENTOMINO_J,
+    PENTOMINO_K,
+    PENTOMINO_L,
+    PENTOMINO_N,
+    PENTOMINO_P,
+    PENTOMINO_Q,
+    PENTOMINO_S,
+    PENTOMINO_T,
+    PENTOMINO_U,
+    PENTOMINO_V,
+    PENTOMINO_W,
+    PENTOMINO_X,
+    PENTOMINO_Y,
+    PENTOMINO_Z,
+    PENTOMINO_NULL = 99
+};
+
+#define PENTOMINO_TYPES         (PENTOMINO_Z+1)     //Number of different configurations.
+
+struct PENTOMINO_TINT
+{
+    unsigned char uc_Red;
+    unsigned char uc_Green;
+    unsigned char uc_Blue;
+};
+
+//Color scheme of each pentomino based on its configuration.
+static std::map<unsigned char, PENTOMINO_TINT> m_Tint = {
+    {PENTOMINO_C, {85,43,0}},
+    {PENTOMINO_D, {170,85,255}},
+    {PENTOMINO_F, {0,85,0}},
+    {PENTOMINO_I, {85,255,170}},
+    {PENTOMINO_J, {0,0,255}},
+    {PENTOMINO_K, {85,0,0}},
+    {PENTOMINO_L, {255,128,0}},
+    {PENTOMINO_N, {255,0,0}},
+    {PENTOMINO_P, {255,255,0}},
+    {PENTOMINO_Q, {170,170,0}},
+    {PENTOMINO_S, {0,128,255}},
+    {PENTOMINO_T, {128,0,255}},
+    {PENTOMINO_U, {0,255,0}},
+    {PENTOMINO_V, {0,255,255}},
+    {PENTOMINO_W, {255,0,128}},
+    {PENTOMINO_X, {43,0,85}},
+    {PENTOMINO_Y, {255,128,255}},
+    {PENTOMINO_Z, {255,170,85}},
+    {PENTOMINO_NULL,{30,30,30}}
+};
+
+struct PENTOMINO_INITIAL_POSITION
+{
+    int n;  //Block of the pentomino.
+    int x;  //That block's initial x.
+    int y;  //That block's initial y.
+    int dx; //Horizontal movement on counterclockwise rotation.
+    int dy; //Vertical movement on counterclockwise rotation.
+};
+
+//Initial position of each block of each type of pentomino. Initial orientation is always horizontal, flat side down.
+static constexpr PENTOMINO_INITIAL_POSITION c_InitialPosition[PENTOMINO_TYPES][5] = {
+    {   //C
+        {0,0,0,  1, 1}, //
+        {1,0,1,  2, 0}, //   __    __
+        {2,1,1,  1,-1}, //  |__|__|__|
+        {3,2,1,  0,-2}, //  |__|__|__|
+        {4,2,0, -1,-1}  //
+    },
+
+    {   //D
+        {0,1,0,  0, 1}, //  Because D sounds like T.
+        {1,0,1,  2, 1}, //      __
+        {2,1,1,  1, 0}, //   __|__|__ __
+        {3,2,1,  0,-1}, //  |__|__|__|__|
+        {4,3,1, -1,-2}  //
+    },
+
+    {   //F
+        {0,1,0, -1, 1}, //      __
+        {1,1,1,  0, 0}, //     |__|__
+        {2,2,1, -1,-1}, //   __|__|__|
+        {3,1,2,  1,-1}, //  |__|__|
+        {4,0,2,  2, 0}  //
+    },
+
+    {   //I
+        {0,0,0,  2, 2}, //
+        {1,1,0,  1, 1}, //   __ __ __ __ __
+        {2,2,0,  0, 0}, //  |__|__|__|__|__|
+        {3,3,0, -1,-1}, //
+        {4,4,0, -2,-2}  //
+    },
+
+    {   //J
+        {0,0,0,  1, 2}, //
+        {1,0,1,  2, 1}, //   __
+        {2,1,1,  1, 0}, //  |__|__ __ __
+        {3,2,1,  0,-1}, //  |__|__|__|__|
+        {4,3,1, -1,-2}  //
+    },
+
+    {   //K
+        {0,1,0, -1, 1}, //      __
+        {1,0,1,  1, 1}, //   __|__|
+        {2,1,1,  0, 0}, //  |__|__|__
+        {3,1,2,  1,-1}, //     |__|__|
+        {4,2,2,  0,-2}  //
+    },
+
+    {   //L
+        {0,3,0, -2,-1}, //
+        {1,0,1,  2, 1}, //            __
+        {2,1,1,  1, 0}, //   __ __ __|__|
+        {3,2,1,  0,-1}, //  |__|__|__|__|
+        {4,3,1, -1,-2}  //
+    },
+
+    {   //N
+        {0,0,0,  1, 2}, //
+        {1,1,0,  0, 1}, //   __ __
+        {2,1,1,  1, 0}, //  |__|__|__ __
+        {3,2,1,  0,-1}, //     |__|__|__|
+        {4,3,1, -1,-2}  //
+    },
+
+    {   //P
+        {0,0,0,  1, 1}, //
+        {1,1,0,  0, 0}, //   __ __
+        {2,0,1,  2, 0}, //  |__|__|__
+        {3,1,1,  1,-1}, //  |__|__|__|
+        {4,2,1,  0,-2}  //
+    },
+
+    {   //Q
+        {0,1,0,  0, 0}, //
+        {1,2,0, -1,-1}, //      __ __
+        {2,0,1,  2, 0}, //   __|__|__|
+        {3,1,1,  1,-1}, //  |__|__|__|
+        {4,2,1,  0,-2}  //
+    },
+
+    {   //S
+        {0,1,0, -1, 1}, //      __ __
+        {1,2,0, -2, 0}, //     |__|__|
+        {2,1,1,  0, 0}, //   __|__|
+        {3,0,2,  2, 0}, //  |__|__|
+        {4,1,2,  1,-1}  //
+    },
+
+    {   //T
+        {0,1,0, -1, 1}, //      __
+        {1,1,1,  0, 0}, //     |__|
+        {2,0,2,  2, 0}, //   __|__|__
+        {3,1,2,  1,-1}, //  |__|__|__|
+        {4,2,2,  0,-2}  //
+    },
+
+    {   //U
+        {0,2,0, -1, 0}, //  A lowercase U, kind of.
+        {1,3,0, -2,-1}, //         __ __
+        {2,0,1,  2, 1}, //   __ __|__|__|
+        {3,1,1,  1, 0}, //  |__|__|__|
+        {4,2,1,  0,-1}  //
+    },
+
+    {   //V
+        {0,2,0, -2, 0}, //         __
+        {1,2,1, -1,-1}, //        |__|
+        {2,2,2,  0,-2}, //   __ __|__|
+        {3,1,2,  1,-1}, //  |__|__|__|
+        {4,0,2,  2, 0}  //
+    },
+
+    {   //W
+        {0,0,0,  0, 2}, //   __
+        {1,0,1,  1, 1}, //  |__|__
+        {2,1,1,  0, 0}, //  |__|__|__
+        {3,1,2,  1,-1}, //     |__|__|
+        {4,2,2,  0,-2}  //
+    },
+
+    {   //X
+        {0,1,0, -1, 1}, //      __
+        {1,0,1,  1, 1}, //   __|__|__
+        {2,1,1,  0, 0}, //  |__|__|__|
+        {3,2,1, -1,-1}, //     |__|
+        {4,1,2,  1,-1}  //
+    },
+
+    {   //Y
+        {0,2,0, -1, 0}, //
+        {1,0,1,  2, 1}, //         __
+        {2,1,1,  1, 0}, //   __ __|__|__
+        {3,2,1,  0,-1}, //  |__|__|__|__|
+        {4,3,1, -1,-2}  //
+    },
+
+    {   //Z
+        {0,0,0,  0, 2}, //   __ __
+        {1,1,0, -1, 1}, //  |__|__|
+        {2,1,1,  0, 0}, //     |__|__
+        {3,1,2,  1,-1}, //     |__|__|
+        {4,2,2,  0,-2}, //
+    }
+};
+
+struct PENTOMINO_SHAPE
+{
+    signed char     x[5], y[5]  ;   //Position of each block relative to the pentomino's origin.
+    signed char     left, right ;   //Leftmost and rightmost columns, relative to the origin.
+    signed char     top, bottom ;   //Topmost and bottommost rows, relative to the origin.
+    unsigned int    mask[5]     ;   //One bitmask per row from the top; bit 0 is the leftmost column.
+    signed char     base[5]     ;   //Lowest block in each column from the left, relative to the origin.
+};
+
+struct PENTOMINO_SHAPE_TABLE
+{
+    PENTOMINO_SHAPE shape[PENTOMINO_TYPES][4];  //Every configuration in every orientation.
+};
+
+//Works out all four orientations of every pentomino by replaying the rotation data, once, at compile time.
+//Each clockwise rotation moves a block by (dy,-dx) and turns its rotation data into (-dy,dx).
+constexpr PENTOMINO_SHAPE_TABLE makeShapeTable()
+{
+    PENTOMINO_SHAPE_TABLE t{};
+    for(int p = 0; p < PENTOMINO_TYPES; p++)
+    {
+        int x[5] = {}, y[5] = {}, dx[5] = {}, dy[5] = {};
+        for(int i = 0; i < 5; i++)
+        {
+            x[i] = c_InitialPosition[p][i].x;
+            y[i] = c_InitialPosition[p][i].y;
+            dx[i] = c_InitialPosition[p][i].dx;
+            dy[i] = c_InitialPosition[p][i].dy;
+        }
+
+        for(int o = 0; o < 4; o++)
+        {
+            PENTOMINO_SHAPE& s = t.shape[p][o];
+            s.left = s.top = 127;
+            s.right = s.bottom = -128;
+            for(int i = 0; i < 5; i++)
+            {
+                s.x[i] = x[i];
+                s.y[i] = y[i];
+                s.left = x[i] < s.left ? x[i] : s.left;
+                s.right = x[i] > s.right ? x[i] : s.right;
+                s.top = y[i] < s.top ? y[i] : s.top;
+                s.bottom = y[i] > s.bottom ? y[i] : s.bottom;
+            }
+            for(int i = 0; i < 5; i++)
+            {
+                s.base[i] = -128;
+            }
+            for(int i = 0; i < 5; i++)
+            {
+                s.mask[y[i]-s.top] |= 1u << (x[i]-s.left);
+                s.base[x[i]-s.left] = y[i] > s.base[x[i]-s.left] ? y[i] : s.base[x[i]-s.left];
+            }
+
+            //Rotate clockwise into the next orientation.
+            for(int i = 0; i < 5; i++)
+            {
+                int ddx = dx[i];
+                x[i] += dy[i];
+                y[i] -= ddx;
+                dx[i] = -dy[i];
+                dy[i] = ddx;
+            }
+        }
+    }
+    return t;
+}
+
+//Shape of every pentomino in every orientation. Orientation counts clockwise rotations from spawn.
+static constexpr PENTOMINO_SHAPE_TABLE c_Shapes = makeShapeTable();
+
+#define PENTOMINO_KICKS         5                   //Rotation candidates per turn: the plain rotation, then 4 kickoffs.
+
+struct PENTOMINO_KICKOFF
+{
+    unsigned char type;
+    signed char ri, rf;
+    signed char kx1, ky1;
+    signed char kx2, ky2;
+    signed char kx3, ky3;
+    signed char kx4, ky4;
+};
+
+//Table of kickoff tests based on pentomino configuration, as well as initial and final orientations.
+static constexpr PENTOMINO_KICKOFF c_KickoffList[] = {
+    {PENTOMINO_C, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_C, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_C, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_C, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_C, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_C, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_C, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_C, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_D, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_D, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_D, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_D, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_D, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_D, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_D, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_D, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_F, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_F, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_F, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_F, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_F, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_F, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_F, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_F, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_I, 0,1,   1,-1,   -1, 1,    2,-2,    -2, 2},
+    {PENTOMINO_I, 1,0,   1,-1,   -1, 1,    2,-2,    -2, 2},
+    {PENTOMINO_I, 1,2,   1, 1,   -1,-1,    2, 2,    -2,-2},
+    {PENTOMINO_I, 2,1,   1, 1,   -1,-1,    2, 2,    -2,-2},
+    {PENTOMINO_I, 2,3,   1,-1,   -1, 1,    2,-2,    -2, 2},
+    {PENTOMINO_I, 3,2,   1,-1,   -1, 1,    2,-2,    -2, 2},
+    {PENTOMINO_I, 3,0,   1, 1,   -1,-1,    2, 2,    -2,-2},
+    {PENTOMINO_I, 0,3,   1, 1,   -1,-1,    2, 2,    -2,-2},
+
+    {PENTOMINO_J, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_J, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_J, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_J, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_J, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_J, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_J, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_J, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_K, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_K, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_K, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_K, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_K, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_K, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_K, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_K, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_L, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_L, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_L, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_L, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_L, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_L, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_L, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_L, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_N, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_N, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_N, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_N, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_N, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_N, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_N, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_N, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_P, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_P, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_P, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_P, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_P, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_P, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_P, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_P, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_Q, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_Q, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_Q, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_Q, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_Q, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_Q, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_Q, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_Q, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_S, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_S, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_S, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_S, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_S, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_S, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_S, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_S, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_T, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_T, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_T, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_T, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_T, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_T, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_T, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_T, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_U, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_U, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_U, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_U, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_U, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_U, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_U, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_U, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_V, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_V, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_V, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_V, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_V, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_V, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_V, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_V, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_W, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_W, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_W, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_W, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_W, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_W, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_W, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_W, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_X, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_X, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_X, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_X, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_X, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_X, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_X, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_X, 0,3,    1,0,    1,-1,    0, 2,     1, 2},
+
+    {PENTOMINO_Y, 0,1,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_Y, 1,0,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_Y, 1,2,   -1,0,    2, 0,   -1,-2,     2, 1},
+    {PENTOMINO_Y, 2,1,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_Y, 2,3,    2,0,   -1, 0,    2,-1,    -1, 2},
+    {PENTOMINO_Y, 3,2,   -2,0,    1, 0,   -2, 1,     1,-2},
+    {PENTOMINO_Y, 3,0,    1,0,   -2, 0,    1, 2,    -2,-1},
+    {PENTOMINO_Y, 0,3,   -1,0,    2, 0,   -1,-2,     2, 1},
+
+    {PENTOMINO_Z, 0,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_Z, 1,0,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_Z, 1,2,    1,0,    1, 1,    0,-2,     1,-2},
+    {PENTOMINO_Z, 2,1,   -1,0,   -1,-1,    0, 2,    -1, 2},
+    {PENTOMINO_Z, 2,3,    1,0,    1,-1,    0, 2,     1, 2},
+    {PENTOMINO_Z, 3,2,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_Z, 3,0,   -1,0,   -1, 1,    0,-2,    -1,-2},
+    {PENTOMINO_Z, 0,3,    1,0,    1,-1,    0, 2,     1, 2}
+};
+
+struct PENTOMINO_KICK
+{
+    signed char x, y;   //Translation applied to the origin.
+};
+
+struct PENTOMINO_KICK_TABLE
+{
+    PENTOMINO_KICK kick[PENTOMINO_TYPES][4][4][PENTOMINO_KICKS];    //Indexed by configuration, initial and final orientation, then test.
+};
+
+//Spreads the kickoff list into a dense table, once, at compile time. Test 0 is always the plain rotation.
+constexpr PENTOMINO_KICK_TABLE makeKickTable()
+{
+    PENTOMINO_KICK_TABLE t{};
+    for(const PENTOMINO_KICKOFF& k : c_KickoffList)
+    {
+        PENTOMINO_KICK* c = t.kick[k.type][k.ri][k.rf];
+        c[1] = {k.kx1, k.ky1};
+        c[2] = {k.kx2, k.ky2};
+        c[3] = {k.kx3, k.ky3};
+        c[4] = {k.kx4, k.ky4};
+    }
+    return t;
+}
+
+//Every kickoff test, looked up by plain indexing.
+static constexpr PENTOMINO_KICK_TABLE c_Kicks = makeKickTable();
+
+class Pentomino
+{
+    public:
+    Pentomino(unsigned char uc_type);                                   //Constructor. No destructor; pentominoes live in a pool.
+
+    //Inlines
+    const PENTOMINO_KICK* getKicks(char rf)     {return c_Kicks.kick[this->getType()][this->getOrientation()%4][rf%4];}  //All candidates for turning to orientation rf.
+    const PENTOMINO_SHAPE& getShape()           {return c_Shapes.shape[this->getType()][(int)this->getOrientation()];}
+    int             getBlockX(unsigned char n)  {return this->getX() + this->getShape().x[n];}
+    int             getBlockY(unsigned char n)  {return this->getY() + this->getShape().y[n];}
+    void            drop()                      {this->i_Y++;}  //Same as setY(getY()+1).
+
+    //Gets
+    unsigned char   getN()                      {return this->uc_N;}
+    unsigned char   getType()                   {return this->uc_Type;}
+    char            getOrientation()            {return this->c_Orientation;}
+    int             getX()                      {return this->i_X;}
+    int             getY()                      {return this->i_Y;}
+    int             getShadow()                 {return this->i_Shadow;}
+
+    //Sets
+    void setN(unsigned char uc)                 {this->uc_N = uc;}
+    void setType(unsigned char uc)              {this->uc_Type = uc;}
+    void setOrientation(char c)                 {this->c_Orientation = c;}
+    void setX(int i)                            {this->i_X = i;}
+    void setY(int i)                            {this->i_Y = i;}
+    void setShadow(int i)                       {this->i_Shadow = i;}
+
+
+    private:
+    unsigned char       uc_N                        = 5;                //Number of blocks (should normally be 5).
+    unsigned char       uc_Type                     = PENTOMINO_NULL;   //Configuration of the pentomino.
+    char                c_Orientation               = 0;                //Orientation (starts at 0). Counts -clockwise- rotations.
+    int                 i_X                         = UTIL_INITIAL_X;   //Column of the pentomino's origin.
+    int                 i_Y                         = UTIL_INITIAL_Y;   //Row of the pentomino's origin.
+    int                 i_Shadow                    = 0;                //Location of the shadow.
+
+};
+
+#endif //PENTOMINO_H
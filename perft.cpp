@@ -0,0 +1,305 @@
+/*
+
+    =================
+    ===== PERFT =====
+    =================
+
+    Counts every sequence of placements reachable from a board, like
+     the perft tool of a chess engine.
+    Each pentomino in the queue is spawned where the game would spawn it
+     and placed everywhere the move generator can reach, lines are
+     cleared, and the next pentomino is tried on every resulting board.
+    The counts pin down the rotation, kickoff and collision rules, and
+     the timing shows how fast the search runs.
+
+    Usage:
+        perft <depth> <queue> [board]   Counts placement sequences for each depth up to <depth>.
+                                        <queue> is a string of pentomino letters, repeated if
+                                         shorter than <depth>. [board] is a text file of rows,
+                                         '.' for empty and anything else for filled, lined up
+                                         with the bottom of the board.
+        perft --verify                  Checks a fixed set of positions against known counts,
+                                         and plays every placement's path on a board.
+
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include <utilities.h>
+#include <pentomino.h>
+#include <movegen.h>
+
+#define PERFT_MAX_DEPTH         8                                       //Deepest search allowed.
+
+static const char c_Letters[] = "CDFIJKLNPQSTUVWXYZ";                   //Letter of each pentomino, in configuration order.
+
+struct PERFT_POSITION
+{
+    const char*         queue;      //Pentominoes to place.
+    int                 depth;      //How many of them to place.
+    const char*         board;      //Rows lined up with the bottom of the board, '/' between rows. Empty for an empty board.
+    unsigned long long  nodes;      //Known-good count.
+};
+
+//Known-good counts. Any change to them has to be explained by a deliberate change to the rules.
+static const PERFT_POSITION c_Positions[] = {
+    {"I",       1,  "",                                                     22},
+    {"X",       1,  "",                                                     11},
+    {"CDF",     3,  "",                                                     95828},
+    {"TYZ",     2,  "#.#########.#/#.#########.#/#####.#######",            1996},
+    {"LNW",     3,  "..##.......##/#.###.#####.#/#########.###",            92809},
+    {"TL",      2,  "#######....../............./.............",            2660},
+};
+
+
+//Turns a string of letters into pentomino types. False on an unknown letter.
+static bool parseQueue(const char* s, unsigned char* queue, int n)
+{
+    int l = strlen(s);
+    if(l == 0)
+    {
+        return false;
+    }
+
+    for(int i = 0; i < n; i++)
+    {
+        const char* c = strchr(c_Letters, s[i%l]);
+        if(!c || !*c)
+        {
+            return false;
+        }
+        queue[i] = c-c_Letters;
+    }
+    return true;
+}
+
+//Fills rows from lines of text, lined up with the bottom of the board. False if it doesn't fit.
+static bool parseBoard(const char* s, char separator, unsigned int* rows)
+{
+    memset(rows, 0, UTIL_GRID_ROWS*sizeof(rows[0]));
+
+    //Count the lines first, so the last one lands on the bottom row.
+    int lines = 0;
+    for(const char* c = s; *c; c++)
+    {
+        lines += (*c == separator && c[1]);
+    }
+    lines += (*s != 0);
+    if(lines > UTIL_GRID_HEIGHT)
+    {
+        return false;
+    }
+
+    int y = UTIL_GRID_ROWS-lines;
+    int x = 0;
+    for(const char* c = s; *c; c++)
+    {
+        if(*c == separator)
+        {
+            y++;
+            x = 0;
+            continue;
+        }
+        if(*c == '\r')
+        {
+            continue;
+        }
+        if(x >= UTIL_GRID_WIDTH)
+        {
+            return false;
+        }
+        if(*c != '.')
+        {
+            rows[y] |= 1u << x;
+        }
+        x++;
+    }
+    return true;
+}
+
+//Counts the placement sequences of the rest of the queue.
+static unsigned long long perft(MoveGen* gen, unsigned int (*rows)[UTIL_GRID_ROWS], const unsigned char* queue, int depth, unsigned long long* generated)
+{
+    if(depth == 0)
+    {
+        return 1;
+    }
+
+    int n = gen->generate(rows[0], queue[0], UTIL_INITIAL_X, UTIL_INITIAL_Y, 0);
+    (*generated)++;
+    if(depth == 1)
+    {
+        return n;   //No need to place the last pentomino just to count it.
+    }
+
+    unsigned long long nodes = 0;
+    for(int i = 0; i < n; i++)
+    {
+        gen->result(i, rows[1]);
+        nodes += perft(gen+1, rows+1, queue+1, depth-1, generated);
+    }
+    return nodes;
+}
+
+//Runs perft from a position and reports how long it took.
+static unsigned long long run(const unsigned int* board, const unsigned char* queue, int depth, bool report)
+{
+    static MoveGen gen[PERFT_MAX_DEPTH];                //One per level, so each keeps its placements while the next one searches.
+    static unsigned int rows[PERFT_MAX_DEPTH+1][UTIL_GRID_ROWS];
+    memcpy(rows[0], board, sizeof(rows[0]));
+
+    unsigned long long generated = 0;
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    unsigned long long nodes = perft(gen, rows, queue, depth, &generated);
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if(report)
+    {
+        printf("depth %d  nodes %12llu  searches %10llu  %9.3f s  %12.0f nodes/s  %10.0f searches/s\n",
+               depth, nodes, generated, seconds, seconds > 0 ? nodes/seconds : 0.0, seconds > 0 ? generated/seconds : 0.0);
+    }
+    return nodes;
+}
+
+//Plays every path from a position on a real board, for every pentomino. Returns the number that fail.
+//A path has to end in its only hard drop, since the game locks on one, and has to arrive where it says.
+static int checkPaths(const unsigned int* rows, int* checked)
+{
+    static MoveGen gen;
+    Board board;
+    for(int y = -UTIL_GRID_CEILING; y < UTIL_GRID_HEIGHT; y++)
+    {
+        for(int x = 0; x < UTIL_GRID_WIDTH; x++)
+        {
+            if((rows[y+UTIL_GRID_CEILING] >> x) & 1)
+            {
+                board.setCell(x, y, PENTOMINO_NULL);
+            }
+        }
+    }
+
+    int failed = 0;
+    for(int t = 0; t < PENTOMINO_TYPES; t++)
+    {
+        if(!board.spawnPentomino(t))
+        {
+            continue;
+        }
+
+        int n = gen.generate(&board);
+        for(int i = 0; i < n; i++)
+        {
+            unsigned char path[MOVEGEN_MAX_PATH];
+            int l = gen.getPath(i, path);
+            bool ok = (path[l-1] == MOVE_DROP);
+            for(int k = 0; k < l-1; k++)
+            {
+                ok = ok && path[k] != MOVE_DROP;
+            }
+
+            Board b = board;
+            ok = ok && gen.play(&b, i);
+            failed += !ok;
+        }
+        *checked += n;
+    }
+    return failed;
+}
+
+//Checks every known position. Returns the number of mismatches.
+static int verify()
+{
+    int failed = 0;
+    for(const PERFT_POSITION& p : c_Positions)
+    {
+        unsigned int board[UTIL_GRID_ROWS];
+        unsigned char queue[PERFT_MAX_DEPTH];
+        parseBoard(p.board, '/', board);
+        parseQueue(p.queue, queue, p.depth);
+
+        unsigned long long nodes = run(board, queue, p.depth, false);
+        bool ok = (nodes == p.nodes);
+        failed += !ok;
+        printf("%-4s %-6s depth %d  expected %12llu  got %12llu\n", ok ? "ok" : "FAIL", p.queue, p.depth, p.nodes, nodes);
+
+        int checked = 0;
+        int bad = checkPaths(board, &checked);
+        failed += (bad > 0);
+        printf("%-4s %-6s paths    played %12d  failed %9d\n", bad ? "FAIL" : "ok", p.queue, checked, bad);
+    }
+    return failed;
+}
+
+//Reads a whole text file. False if it can't be read.
+static bool readFile(const char* path, char* buffer, int size)
+{
+    FILE* f = fopen(path, "rb");
+    if(!f)
+    {
+        return false;
+    }
+    int n = fread(buffer, 1, size-1, f);
+    fclose(f);
+    buffer[n] = 0;
+
+    //Drop trailing line breaks so they don't count as rows.
+    while(n > 0 && (buffer[n-1] == '\n' || buffer[n-1] == '\r'))
+    {
+        buffer[--n] = 0;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+    if(argc == 2 && !strcmp(argv[1], "--verify"))
+    {
+        return verify() ? 1 : 0;
+    }
+
+    if(argc < 3 || argc > 4)
+    {
+        fprintf(stderr, "usage: %s <depth> <queue> [board]\n       %s --verify\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    int depth = atoi(argv[1]);
+    if(depth < 1 || depth > PERFT_MAX_DEPTH)
+    {
+        fprintf(stderr, "depth must be between 1 and %d\n", PERFT_MAX_DEPTH);
+        return 2;
+    }
+
+    unsigned char queue[PERFT_MAX_DEPTH];
+    if(!parseQueue(argv[2], queue, depth))
+    {
+        fprintf(stderr, "queue must only use the letters %s\n", c_Letters);
+        return 2;
+    }
+
+    unsigned int board[UTIL_GRID_ROWS];
+    char text[4096] = "";
+    if(argc == 4 && !readFile(argv[3], text, sizeof(text)))
+    {
+        fprintf(stderr, "cannot read %s\n", argv[3]);
+        return 2;
+    }
+    if(!parseBoard(text, '\n', board))
+    {
+        fprintf(stderr, "board must be at most %d rows of %d cells\n", UTIL_GRID_HEIGHT, UTIL_GRID_WIDTH);
+        return 2;
+    }
+
+    //Count each depth in turn, the way chess engines report perft.
+    for(int d = 1; d <= depth; d++)
+    {
+        run(board, queue, d, true);
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////
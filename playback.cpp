@@ -0,0 +1,99 @@
+#include "playback.h"
+
+Playback::Playback()
+{
+    //Nothing loaded yet.
+}
+
+Playback::~Playback()
+{
+    //Keyframes are owned by value; nothing to unload.
+}
+
+
+//Loads a replay file and indexes it.
+bool Playback::load(const char* path)
+{
+    if(!this->r_Replay.load(path))
+    {
+        return false;
+    }
+
+    this->index();
+    return true;
+}
+
+//Plays the loaded replay through once, keeping a keyframe every interval.
+void Playback::index()
+{
+    this->v_Keyframes.clear();
+    this->v_Keyframes.reserve(this->r_Replay.getCount()/PLAYBACK_KEYFRAME_INTERVAL + 1);
+
+    this->g_Game.newGame(this->r_Replay.getSeed());
+    for(unsigned int i = 0; i < this->r_Replay.getCount(); i++)
+    {
+        if(i%PLAYBACK_KEYFRAME_INTERVAL == 0)
+        {
+            this->v_Keyframes.push_back(this->g_Game);
+        }
+        this->g_Game.act(this->r_Replay.getAction(i));
+    }
+
+    //The game is now at its very end.
+    this->ui_Next = this->r_Replay.getCount();
+    this->ui_Tick = this->getLength();
+}
+
+//Jumps to any point in the game.
+void Playback::seek(unsigned int ui_tick)
+{
+    //Find the first action after this tick. Ticks only ever go up.
+    unsigned int lo = 0, hi = this->r_Replay.getCount();
+    while(lo < hi)
+    {
+        unsigned int mid = (lo+hi)/2;
+        if(this->r_Replay.getTick(mid) <= ui_tick)
+        {
+            lo = mid+1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    unsigned int target = lo;
+
+    //Restore the nearest keyframe before it, unless the game is already between that keyframe and the target.
+    //Past the last keyframe, as at the very end of a replay, the last one is nearest.
+    unsigned int k = std::min<unsigned int>(target/PLAYBACK_KEYFRAME_INTERVAL, this->v_Keyframes.size() ? this->v_Keyframes.size()-1 : 0);
+    if(this->ui_Next > target || this->ui_Next < k*PLAYBACK_KEYFRAME_INTERVAL)
+    {
+        if(!this->v_Keyframes.empty())
+        {
+            this->g_Game = this->v_Keyframes[k];
+        }
+        else
+        {
+            //No index to start from.
+            this->g_Game.newGame(this->r_Replay.getSeed());
+        }
+        this->ui_Next = k*PLAYBACK_KEYFRAME_INTERVAL;
+    }
+
+    //Replay the rest of the way.
+    for(; this->ui_Next < target; this->ui_Next++)
+    {
+        this->g_Game.act(this->r_Replay.getAction(this->ui_Next));
+    }
+    this->ui_Tick = ui_tick;
+}
+
+//Plays forward by some number of ticks.
+void Playback::advance(unsigned int ui_ticks)
+{
+    this->ui_Tick += ui_ticks;
+    while(this->ui_Next < this->r_Replay.getCount() && this->r_Replay.getTick(this->ui_Next) <= this->ui_Tick)
+    {
+        this->g_Game.act(this->r_Replay.getAction(this->ui_Next++));
+    }
+}
@@ -0,0 +1,60 @@
+/*
+
+    ====================
+    ===== PLAYBACK =====
+    ====================
+
+    Plays a replay back through the real game rules.
+    Loading a replay plays the whole game through once, as fast as it
+     will go, and keeps a full copy of the game every so many actions.
+    Those keyframes make seeking cheap: jumping anywhere restores the
+     nearest keyframe before it and replays at most one interval of
+     actions from there.
+    Time only moves when told to, so the same engine serves a window
+     watching at any speed and a batch tool that wants the end result.
+
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include <utilities.h>
+#include <game.h>
+#include <replay.h>
+
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#define PLAYBACK_KEYFRAME_INTERVAL  256                                 //Actions between keyframes.
+
+
+class Playback
+{
+    public:
+    Playback();     //Constructor
+    ~Playback();    //Destructor
+
+    bool load(const char* path);                //Loads a replay file and indexes it. False if it can't be read.
+    void index();                               //Plays the loaded replay through once, keeping a keyframe every interval.
+    void seek(unsigned int ui_tick);            //Jumps to any tick of the game.
+    void advance(unsigned int ui_ticks);        //Plays forward by some number of ticks.
+
+
+    //Gets
+    Game*           getGame()                   {return &this->g_Game;}
+    Replay*         getReplay()                 {return &this->r_Replay;}
+    unsigned int    getTick()                   {return this->ui_Tick;}
+    unsigned int    getLength()                 {return this->r_Replay.getCount() ? this->r_Replay.getTick(this->r_Replay.getCount()-1) : 0;}     //In ticks.
+    bool            getFinished()               {return this->ui_Next >= this->r_Replay.getCount();}
+    unsigned int    getKeyframes()              {return this->v_Keyframes.size();}
+
+
+    private:
+    Replay              r_Replay                ;       //The game being played back.
+    Game                g_Game                  ;       //The game as it stands at the current tick.
+    std::vector<Game>   v_Keyframes             ;       //A copy of the game before every interval of actions.
+    unsigned int        ui_Next                 = 0;    //Next action to play.
+    unsigned int        ui_Tick                 = 0;    //Current tick.
+};
+
+#endif //PLAYBACK_H
@@ -0,0 +1,74 @@
+/*
+
+    ================
+    ===== POOL =====
+    ================
+
+    Fixed storage for up to N objects of one type.
+    Objects are built in place in the pool's own memory and handed back
+     to it when they are done with, so nothing here ever touches the heap.
+    Released slots are reused first. Resetting the pool forgets every
+     object at once, so only types with nothing to clean up may live here.
+
+*/
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#ifndef POOL_H
+#define POOL_H
+
+
+template <typename T, int N>
+class Pool
+{
+    static_assert(std::is_trivially_destructible<T>::value, "Pooled objects are forgotten on reset, so they must not need destroying.");
+
+    public:
+    //Builds a new object in a free slot. Returns nullptr if the pool is full.
+    template <typename... A>
+    T* acquire(A&&... a)
+    {
+        int i;
+        if(this->i_Released > 0)
+        {
+            i = this->i_Free[--this->i_Released];   //Reuse a released slot.
+        }
+        else if(this->i_Used < N)
+        {
+            i = this->i_Used++;                     //Take a fresh slot.
+        }
+        else
+        {
+            return nullptr;                         //Pool is full.
+        }
+
+        return new(this->c_Storage[i]) T(std::forward<A>(a)...);
+    }
+
+    //Hands an object back to the pool. Null is ignored, like delete.
+    void release(T* t)
+    {
+        if(t)
+        {
+            this->i_Free[this->i_Released++] = (reinterpret_cast<unsigned char(*)[sizeof(T)]>(t) - this->c_Storage);
+        }
+    }
+
+    //Forgets every object at once.
+    void reset()            {this->i_Used = 0; this->i_Released = 0;}
+
+    //Gets
+    int getLive()           {return this->i_Used - this->i_Released;}
+    int getCapacity()       {return N;}
+
+
+    private:
+    alignas(T) unsigned char    c_Storage[N][sizeof(T)]     ;       //Raw memory for every slot.
+    int                         i_Free[N]                   ;       //Slots that have been released.
+    int                         i_Used                      = 0;    //Slots handed out at least once since the last reset.
+    int                         i_Released                  = 0;    //Number of released slots waiting to be reused.
+};
+
+#endif //POOL_H
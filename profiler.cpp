@@ -0,0 +1,125 @@
+#include "profiler.h"
+
+static_assert((PROFILER_FRAMES & (PROFILER_FRAMES-1)) == 0, "Frames are kept in rings indexed by masking.");
+
+Profiler::Profiler()
+{
+    //Allocate every ring once, so timing never has to.
+    this->ui_Rings = new unsigned int[PHASE_NULL*PROFILER_FRAMES]();
+    this->v_Scratch.resize(PROFILER_FRAMES);
+    for(int i = 0; i < PHASE_NULL; i++)
+    {
+        this->ui_Current[i] = 0;
+    }
+}
+
+Profiler::~Profiler()
+{
+    delete[] this->ui_Rings;
+}
+
+
+//Adds time to a phase of the frame in progress.
+void Profiler::add(unsigned char uc_phase, unsigned int ui_ns)
+{
+    this->ui_Current[uc_phase] += ui_ns;
+}
+
+//Ends the frame in progress, and starts the next.
+void Profiler::commit()
+{
+    //Write the frame first, then publish it.
+    unsigned int n = this->ui_Frames.load(std::memory_order_relaxed);
+    unsigned int slot = n & (PROFILER_FRAMES-1);
+    for(int i = 0; i < PHASE_NULL; i++)
+    {
+        this->ui_Rings[i*PROFILER_FRAMES + slot] = this->ui_Current[i];
+        this->ui_Current[i] = 0;
+    }
+    this->ui_Frames.store(n+1, std::memory_order_release);
+}
+
+//Works out the spread of every phase over the frames kept.
+void Profiler::summarize()
+{
+    unsigned int n = std::min(this->getFrames(), (unsigned int)PROFILER_FRAMES);
+    if(!n)
+    {
+        return;
+    }
+
+    for(int i = 0; i < PHASE_NULL; i++)
+    {
+        std::vector<unsigned int>& v = this->v_Scratch;
+        std::copy(this->ui_Rings + i*PROFILER_FRAMES, this->ui_Rings + i*PROFILER_FRAMES + n, v.begin());
+
+        //Partial sorts only, from the top down, each within what the last left unsorted.
+        PROFILER_STATS& s = this->s_Stats[i];
+        std::nth_element(v.begin(), v.begin() + (n-1), v.begin() + n);
+        s.max = v[n-1];
+        std::nth_element(v.begin(), v.begin() + n*99/100, v.begin() + (n-1));
+        s.p99 = v[n*99/100];
+        std::nth_element(v.begin(), v.begin() + n/2, v.begin() + n*99/100);
+        s.p50 = v[n/2];
+    }
+    this->ui_Summaries++;
+}
+
+//Writes every frame kept to a CSV file, oldest first.
+bool Profiler::save(const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if(!f)
+    {
+        return false;
+    }
+
+    //One column per phase, in nanoseconds.
+    fprintf(f, "frame");
+    for(int i = 0; i < PHASE_NULL; i++)
+    {
+        fprintf(f, ",%s_ns", c_Phases[i]);
+    }
+    fprintf(f, "\n");
+
+    unsigned int end = this->getFrames();
+    unsigned int start = end > PROFILER_FRAMES ? end - PROFILER_FRAMES : 0;
+    for(unsigned int n = start; n < end; n++)
+    {
+        fprintf(f, "%u", n);
+        for(int i = 0; i < PHASE_NULL; i++)
+        {
+            fprintf(f, ",%u", this->ui_Rings[i*PROFILER_FRAMES + (n & (PROFILER_FRAMES-1))]);
+        }
+        fprintf(f, "\n");
+    }
+
+    return fclose(f) == 0;
+}
+
+
+ProfilerScope::ProfilerScope(Profiler* p, unsigned char uc_phase)
+{
+    this->p_Profiler = p;
+    this->uc_Phase = uc_phase;
+    if(p)
+    {
+        if(p->getTracer())
+        {
+            p->getTracer()->begin(c_Phases[uc_phase]);
+        }
+        this->tp_Start = std::chrono::steady_clock::now();
+    }
+}
+
+ProfilerScope::~ProfilerScope()
+{
+    if(this->p_Profiler)
+    {
+        this->p_Profiler->add(this->uc_Phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->tp_Start).count());
+        if(this->p_Profiler->getTracer())
+        {
+            this->p_Profiler->getTracer()->end(c_Phases[this->uc_Phase]);
+        }
+    }
+}
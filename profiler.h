@@ -0,0 +1,115 @@
+/*
+
+    ====================
+    ===== PROFILER =====
+    ====================
+
+    Where each frame's time goes, phase by phase, for the last few
+     thousand frames.
+    Scopes around each phase add the time they cover to it. Once a frame
+     ends, every phase's total goes into its own ring buffer of frames.
+     Phases can nest, so a phase includes any phase timed inside it.
+    Only one thread writes frames. The count of frames written is
+     published after each one, so anything reading the rings, on any
+     thread, needs no lock. At worst it reads a frame being overwritten.
+    Drawing calls only queue work for the GPU, so draw phases time how
+     long it takes to queue it. Flipping is where waiting on the GPU
+     shows up.
+    With a tracer attached, every phase is also traced as a span, so each
+     frame can be looked at on its own.
+
+*/
+
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+#include <tracer.h>
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#define PROFILER_FRAMES         4096                                    //Frames kept. A power of two.
+#define PROFILER_REFRESH        30                                      //Frames between summaries, while they're shown.
+
+
+//Every phase of a frame that gets timed.
+enum e_Phase
+{
+    PHASE_FRAME,        //Everything but waiting.
+    PHASE_WAIT,         //Waiting for events or the next tick.
+    PHASE_INPUT,        //Handling events.
+    PHASE_TICK,         //Fixed ticks of the game.
+    PHASE_MOVE,         //Moves, rotations and drops, and finding the shadow after each. Part of input or ticks.
+    PHASE_CLEAR,        //Locking and clearing lines. Part of input or ticks.
+    PHASE_PLAYBACK,     //Moving a watched game along.
+    PHASE_AUDIO,        //Handing over assets, playing sounds and swapping music.
+    PHASE_DRAW,         //Drawing the screen, every draw phase below included.
+    PHASE_HUD,          //Redrawing the HUD layer.
+    PHASE_WINDOWS,      //Drawing the preview and hold.
+    PHASE_STACK,        //Redrawing changed rows of dead blocks.
+    PHASE_BOARD,        //Drawing the board.
+    PHASE_FLIP,         //Flipping the display.
+    PHASE_NULL
+};
+
+static const char* const c_Phases[PHASE_NULL] = {"frame", "wait", "input", "tick", "move", "clear", "playback", "audio", "draw", "hud", "windows", "stack", "board", "flip"};
+
+//Spread of one phase's time per frame, in nanoseconds.
+struct PROFILER_STATS
+{
+    unsigned int    p50         = 0;
+    unsigned int    p99         = 0;
+    unsigned int    max         = 0;
+};
+
+
+class Profiler
+{
+    public:
+    Profiler();     //Constructor
+    ~Profiler();    //Destructor
+
+    void add(unsigned char uc_phase, unsigned int ui_ns);   //Adds time to a phase of the frame in progress.
+    void commit();                                          //Ends the frame in progress, and starts the next.
+    void summarize();                                       //Works out the spread of every phase over the frames kept.
+    bool save(const char* path);                            //Writes every frame kept to a CSV file, oldest first. False if it can't be written.
+
+
+    //Gets
+    unsigned int            getFrames()                     {return this->ui_Frames.load(std::memory_order_acquire);}
+    const PROFILER_STATS&   getStats(unsigned char uc)      {return this->s_Stats[uc];}
+    unsigned int            getSummaries()                  {return this->ui_Summaries;}
+    Tracer*                 getTracer()                     {return this->t_Tracer;}
+
+    //Sets
+    void                    setTracer(Tracer* t)            {this->t_Tracer = t;}
+
+
+    private:
+    unsigned int*               ui_Rings            = nullptr;      //Each phase's ring of frames, one after another.
+    unsigned int                ui_Current[PHASE_NULL]  ;           //Each phase's time in the frame in progress.
+    std::atomic<unsigned int>   ui_Frames           {0};            //Frames written in all.
+    PROFILER_STATS              s_Stats[PHASE_NULL]     ;           //Each phase's spread, as of the last summary.
+    unsigned int                ui_Summaries        = 0;            //Summaries made so far.
+    std::vector<unsigned int>   v_Scratch           ;               //Room to sort a ring in.
+    Tracer*                     t_Tracer            = nullptr;      //Traces every phase as a span, if set. Not owned.
+};
+
+
+//Times the rest of its scope against a phase. Does nothing without a profiler.
+class ProfilerScope
+{
+    public:
+    ProfilerScope(Profiler* p, unsigned char uc_phase);     //Constructor. Starts timing, and begins a span if tracing.
+    ~ProfilerScope();                                       //Destructor. Adds the time since construction to the phase, and ends its span.
+
+    private:
+    Profiler*                                       p_Profiler  = nullptr;      //Profiler to add to. Not owned.
+    unsigned char                                   uc_Phase    = PHASE_NULL;   //Phase to add to.
+    std::chrono::steady_clock::time_point           tp_Start    ;               //When timing started.
+};
+
+#endif //PROFILER_H
@@ -0,0 +1,312 @@
+#include "renderer.h"
+
+static_assert(UTIL_GRID_HEIGHT <= 32, "Every row of the board needs a bit for tracking which rows changed.");
+static_assert(RUN_NULL <= TEXTCACHE_RUNS, "Every line of the HUD needs a run in the text cache.");
+
+Renderer::Renderer(ALLEGRO_FONT* f, Atlas* a)
+{
+    this->f_Font = f;
+    this->a_Atlas = a;
+
+    //The static layer covers the whole screen; the HUD covers everything beside the preview.
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    this->bmp_Static = al_create_bitmap(UTIL_SCREEN_WIDTH, UTIL_SCREEN_HEIGHT);
+    this->bmp_HUD = al_create_bitmap(UTIL_SCREEN_WIDTH - RENDERER_PANEL_X, UTIL_SCREEN_HEIGHT);
+    this->bmp_Stack = al_create_bitmap(UTIL_BOARD_WIDTH, UTIL_BOARD_HEIGHT);
+    this->t_Text = new TextCache(f);
+    this->drawStatic();
+    al_set_target_bitmap(target);
+}
+
+Renderer::~Renderer()
+{
+    delete this->t_Text;
+    al_destroy_bitmap(this->bmp_Stack);
+    al_destroy_bitmap(this->bmp_HUD);
+    al_destroy_bitmap(this->bmp_Static);
+}
+
+
+//Draws a whole frame to the current target.
+void Renderer::draw(Board* b, Preview* p, Hold* h, const RENDERER_HUD& hud, unsigned char uc_paused, bool b_profile)
+{
+    //Redraw the HUD only if something on it changed.
+    const RENDERER_HUD& s = this->hud_Shown;
+    if(!this->b_HUDValid || hud.level != s.level || hud.linesRemaining != s.linesRemaining || hud.score != s.score ||
+       hud.music != s.music || hud.watching != s.watching || hud.time != s.time || hud.length != s.length)
+    {
+        ProfilerScope scope(this->getProfiler(), PHASE_HUD);
+        ALLEGRO_BITMAP* target = al_get_target_bitmap();
+        this->drawHUD(hud);
+        al_set_target_bitmap(target);
+    }
+
+    //Both cached layers, in two draws.
+    al_draw_bitmap(this->getStatic(), 0, 0, 0);
+    al_draw_bitmap(this->getHUD(), RENDERER_PANEL_X, 0, 0);
+
+    //Blocks in play, unless paused.
+    if(!uc_paused)
+    {
+        {
+            ProfilerScope scope(this->getProfiler(), PHASE_WINDOWS);
+            al_hold_bitmap_drawing(true);
+            this->drawWindow(p, 4*UTIL_PREVIEW_NUMBER, UTIL_PREVIEW_X + UTIL_FRAME_THICKNESS, UTIL_PREVIEW_Y);
+            this->drawWindow(h, 4*UTIL_HOLD_NUMBER, UTIL_HOLD_X - UTIL_FRAME_THICKNESS, UTIL_HOLD_Y);
+            al_hold_bitmap_drawing(false);
+        }
+
+        //Bring the dead blocks up to date before drawing anything on the board.
+        {
+            ProfilerScope scope(this->getProfiler(), PHASE_STACK);
+            this->drawStack(b);
+        }
+
+        //The current pentomino can poke above the board, so the board gets its own clipped batch.
+        ProfilerScope scope(this->getProfiler(), PHASE_BOARD);
+        int cx, cy, cw, ch;
+        al_get_clipping_rectangle(&cx, &cy, &cw, &ch);
+        al_set_clipping_rectangle(UTIL_BOARD_X, UTIL_BOARD_Y, UTIL_BOARD_WIDTH, UTIL_BOARD_HEIGHT);
+        al_hold_bitmap_drawing(true);
+        this->drawBoard(b);
+        al_hold_bitmap_drawing(false);
+        al_set_clipping_rectangle(cx, cy, cw, ch);
+    }
+    else if(uc_paused != UTIL_UNPAUSE_TIME+1)
+    {
+        //Unpause in progress. Draw unpause timer ticks.
+        al_draw_textf(this->getFont(),
+                     al_map_rgb(255,255,255),
+                     UTIL_BOARD_X + UTIL_BOARD_WIDTH/2,
+                     UTIL_BOARD_Y + UTIL_BOARD_HEIGHT/2,
+                     ALLEGRO_ALIGN_CENTER,
+                     "%i...",
+                     uc_paused);
+    }
+    else
+    {
+        //Indicate pause.
+        al_draw_text(this->getFont(),
+                     al_map_rgb(255,255,255),
+                     UTIL_BOARD_X + UTIL_BOARD_WIDTH/2,
+                     UTIL_BOARD_Y + UTIL_BOARD_HEIGHT/2,
+                     ALLEGRO_ALIGN_CENTER,
+                     "Pause");
+    }
+
+    if(b_profile && this->getProfiler())
+    {
+        this->drawProfile();
+    }
+}
+
+
+//Draws the static layer into its bitmap.
+void Renderer::drawStatic()
+{
+    al_set_target_bitmap(this->getStatic());
+
+    //Display solid color background.
+    al_clear_to_color(al_map_rgb(0,0,0));
+
+    //Draw title.
+    al_draw_text(this->getFont(),
+                 al_map_rgb(255,255,255),
+                 (RENDERER_PANEL_X + UTIL_SCREEN_WIDTH)/2,
+                 UTIL_BLOCK_SIZE,
+                 ALLEGRO_ALIGN_CENTER,
+                 "PENTRIS");
+
+    //Draw instructions. The music line changes, so it lives on the HUD.
+    al_draw_text(this->getFont(),
+                 al_map_rgb(255,255,255),
+                 (RENDERER_PANEL_X + UTIL_SCREEN_WIDTH)/2,
+                 5*UTIL_BLOCK_SIZE,
+                 ALLEGRO_ALIGN_CENTER,
+                 "Controls");
+
+    const char* controls[] = {"+: Move", "Space: Drop", "Z: Rotate Left", "X: Rotate Right", "C: Hold", "N: New Game", "P: Pause"};
+    for(int i = 0; i < 7; i++)
+    {
+        al_draw_text(this->getFont(), al_map_rgb(255,255,255), RENDERER_TEXT_X, (7+i)*UTIL_BLOCK_SIZE, ALLEGRO_ALIGN_LEFT, controls[i]);
+    }
+    al_draw_text(this->getFont(), al_map_rgb(255,255,255), RENDERER_TEXT_X, 15*UTIL_BLOCK_SIZE, ALLEGRO_ALIGN_LEFT, "R: Watch Last Game");
+
+    //Frame each window: a white border around a black inside.
+    this->drawFrame(UTIL_PREVIEW_X, UTIL_PREVIEW_Y - UTIL_FRAME_THICKNESS, UTIL_PREVIEW_WIDTH, UTIL_PREVIEW_HEIGHT);
+    this->drawFrame(UTIL_HOLD_X - 2*UTIL_FRAME_THICKNESS, UTIL_HOLD_Y - UTIL_FRAME_THICKNESS, UTIL_HOLD_WIDTH, UTIL_HOLD_HEIGHT);
+    this->drawFrame(UTIL_BOARD_X - UTIL_FRAME_THICKNESS, UTIL_BOARD_Y - UTIL_FRAME_THICKNESS, UTIL_BOARD_WIDTH, UTIL_BOARD_HEIGHT);
+}
+
+//Draws a window's frame into the static layer, from the frame's top left corner and the size of what's inside.
+void Renderer::drawFrame(int x, int y, int w, int h)
+{
+    ALLEGRO_BITMAP* frame = al_create_sub_bitmap(this->getStatic(), x, y, w + 2*UTIL_FRAME_THICKNESS, h + 2*UTIL_FRAME_THICKNESS);
+    al_set_target_bitmap(frame);
+    al_clear_to_color(al_map_rgb(255,255,255));
+
+    ALLEGRO_BITMAP* inside = al_create_sub_bitmap(frame, UTIL_FRAME_THICKNESS, UTIL_FRAME_THICKNESS, w, h);
+    al_set_target_bitmap(inside);
+    al_clear_to_color(al_map_rgb(0,0,0));
+
+    //Destroy all sub bitmaps.
+    al_destroy_bitmap(inside);
+    inside = nullptr;
+    al_destroy_bitmap(frame);
+    frame = nullptr;
+}
+
+//Draws the HUD layer into its bitmap.
+void Renderer::drawHUD(const RENDERER_HUD& hud)
+{
+    al_set_target_bitmap(this->getHUD());
+    al_clear_to_color(al_map_rgba(0,0,0,0));
+
+    //Lay out only the lines whose values changed.
+    TextCache* t = this->getText();
+    t->setRun(RUN_MUSIC, hud.music, "M: Music (Type%c)", 65+hud.music);
+    t->setRun(RUN_LEVEL, hud.level, "Level: %i", hud.level);
+    t->setRun(RUN_LINES, hud.linesRemaining, "Lines Needed: %-i", hud.linesRemaining);
+    t->setRun(RUN_SCORE, hud.score, "Score: %lu", hud.score);
+    t->setRun(RUN_WATCHING, ((long long)hud.watching << 40) | ((long long)hud.time << 20) | hud.length,
+              "Watching %ix  %u:%02u / %u:%02u", hud.watching, hud.time/60, hud.time%60, hud.length/60, hud.length%60);
+
+    //Line up with the static text beside it.
+    float x = RENDERER_TEXT_X - RENDERER_PANEL_X;
+    ALLEGRO_COLOR white = al_map_rgb(255,255,255);
+
+    al_hold_bitmap_drawing(true);
+    t->drawRun(RUN_MUSIC, white, x, 14*UTIL_BLOCK_SIZE);
+
+    //Show where playback is, while watching.
+    if(hud.watching)
+    {
+        t->drawRun(RUN_WATCHING, white, x, 17*UTIL_BLOCK_SIZE);
+    }
+
+    t->drawRun(RUN_LEVEL, white, x, 20*UTIL_BLOCK_SIZE);
+    t->drawRun(RUN_LINES, white, x, 21*UTIL_BLOCK_SIZE);
+    t->drawRun(RUN_SCORE, white, x, 23*UTIL_BLOCK_SIZE);
+    al_hold_bitmap_drawing(false);
+
+    this->hud_Shown = hud;
+    this->b_HUDValid = true;
+}
+
+//Redraws any rows of dead blocks that changed since the last frame.
+void Renderer::drawStack(Board* b)
+{
+    //Find the rows that changed: different blocks, or the same blocks in different colors.
+    unsigned int dirty = 0;
+    for(int j = 0; j < UTIL_GRID_HEIGHT; j++)
+    {
+        bool d = !this->b_StackValid || b->getRow(j) != this->ui_StackRows[j];
+        for(int i = 0; i < UTIL_GRID_WIDTH && !d; i++)
+        {
+            d = b->getCell(i,j) && b->getCellType(i,j) != this->uc_StackCells[j][i];
+        }
+        dirty |= (unsigned int)d << j;
+    }
+    if(!dirty)
+    {
+        return;
+    }
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    al_set_target_bitmap(this->getStack());
+
+    //Empty each changed row...
+    for(int j = 0; j < UTIL_GRID_HEIGHT; j++)
+    {
+        if((dirty >> j) & 1)
+        {
+            al_set_clipping_rectangle(0, UTIL_BLOCK_SIZE*j, UTIL_BOARD_WIDTH, UTIL_BLOCK_SIZE);
+            al_clear_to_color(al_map_rgba(0,0,0,0));
+        }
+    }
+    al_reset_clipping_rectangle();
+
+    //...then fill them back in, in one batch.
+    al_hold_bitmap_drawing(true);
+    for(int j = 0; j < UTIL_GRID_HEIGHT; j++)
+    {
+        if(!((dirty >> j) & 1))
+        {
+            continue;
+        }
+
+        this->ui_StackRows[j] = b->getRow(j);
+        for(int i = 0; i < UTIL_GRID_WIDTH; i++)
+        {
+            this->uc_StackCells[j][i] = b->getCellType(i,j);
+            if(b->getCell(i,j))
+            {
+                this->getAtlas()->drawBlock(b->getCellType(i,j), UTIL_BLOCK_SIZE*i, UTIL_BLOCK_SIZE*j);
+            }
+        }
+    }
+    al_hold_bitmap_drawing(false);
+
+    this->b_StackValid = true;
+    al_set_target_bitmap(target);
+}
+
+//Draws the dead blocks, the current pentomino and its shadow.
+void Renderer::drawBoard(Board* b)
+{
+    //Every dead block, in one draw.
+    al_draw_bitmap(this->getStack(), UTIL_BOARD_X, UTIL_BOARD_Y, 0);
+
+    //Draw the current pentomino on top of its shadow.
+    Pentomino* p = b->getCurrentPentomino();
+    if(p)
+    {
+        for(int i = 0; i < p->getN(); i++)
+        {
+            this->getAtlas()->drawShadow(UTIL_BOARD_X + UTIL_BLOCK_SIZE*p->getBlockX(i),
+                                         UTIL_BOARD_Y + UTIL_BLOCK_SIZE*(p->getBlockY(i)+p->getShadow()));
+        }
+        for(int i = 0; i < p->getN(); i++)
+        {
+            this->getAtlas()->drawBlock(p->getType(),
+                                        UTIL_BOARD_X + UTIL_BLOCK_SIZE*p->getBlockX(i),
+                                        UTIL_BOARD_Y + UTIL_BLOCK_SIZE*p->getBlockY(i));
+        }
+    }
+}
+
+//Draws the spread of every phase of a frame over the board, at half size on a black box.
+void Renderer::drawProfile()
+{
+    //Lines only change when a new summary is made.
+    Profiler* pr = this->getProfiler();
+    TextCache* t = this->getText();
+    t->setRun(RUN_PROFILE, 0, "Phase: p50 / p99 / max (us)");
+    for(int i = 0; i < PHASE_NULL; i++)
+    {
+        const PROFILER_STATS& s = pr->getStats(i);
+        t->setRun(RUN_PROFILE+1+i, pr->getSummaries(), "%s: %.1f / %.1f / %.1f", c_Phases[i], s.p50/1000.0, s.p99/1000.0, s.max/1000.0);
+    }
+
+    int line = t->getLineHeight()/2;
+    al_set_clipping_rectangle(UTIL_BOARD_X, UTIL_BOARD_Y, UTIL_BOARD_WIDTH, line*(PHASE_NULL+2));
+    al_clear_to_color(al_map_rgb(0,0,0));
+    al_reset_clipping_rectangle();
+
+    ALLEGRO_TRANSFORM last, half;
+    al_copy_transform(&last, al_get_current_transform());
+    al_identity_transform(&half);
+    al_scale_transform(&half, 0.5, 0.5);
+    al_translate_transform(&half, UTIL_BOARD_X + UTIL_BLOCK_SIZE/4, UTIL_BOARD_Y + line/2);
+    al_use_transform(&half);
+
+    ALLEGRO_COLOR white = al_map_rgb(255,255,255);
+    al_hold_bitmap_drawing(true);
+    for(int i = 0; i <= PHASE_NULL; i++)
+    {
+        t->drawRun(RUN_PROFILE+i, white, 0, i*t->getLineHeight());
+    }
+    al_hold_bitmap_drawing(false);
+
+    al_use_transform(&last);
+}
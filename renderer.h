@@ -0,0 +1,126 @@
+/*
+
+    ====================
+    ===== RENDERER =====
+    ====================
+
+    Draws the screen in three layers, each redrawn only as often as what
+     it shows can change.
+    The static layer holds the title, the controls and the frames around
+     each window. It is drawn once, into its own bitmap.
+    The HUD layer holds the level, lines, score and anything else that
+     changes now and then. It is redrawn into its own bitmap only when one
+     of those values changes, out of the text cache rather than the font.
+    The playfield layer holds the board, preview and hold, and is drawn
+     straight to the screen every frame. Dead blocks only change when a
+     pentomino locks, lines clear or the game ends, so they are kept in
+     a bitmap of their own, and only rows that changed are redrawn.
+    Each frame is then three bitmaps and whatever blocks are in play.
+    With a profiler attached, each part of drawing is timed, and the
+     spread of every phase can be shown over the board.
+
+*/
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+
+#include <utilities.h>
+#include <board.h>
+#include <preview.h>
+#include <hold.h>
+#include <atlas.h>
+#include <textcache.h>
+#include <profiler.h>
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#define RENDERER_TEXT_X     (UTIL_PREVIEW_X + UTIL_PREVIEW_WIDTH + 2*UTIL_BLOCK_SIZE)                       //Left edge of the text beside the preview.
+#define RENDERER_PANEL_X    (UTIL_PREVIEW_X + UTIL_PREVIEW_WIDTH + 2*UTIL_FRAME_THICKNESS)                  //Left edge of everything beside the preview.
+
+
+//Each line of the HUD, as a run in the text cache.
+enum e_Run
+{
+    RUN_MUSIC,
+    RUN_WATCHING,
+    RUN_LEVEL,
+    RUN_LINES,
+    RUN_SCORE,
+    RUN_PROFILE,                                //Heading of the profile. A line for each phase follows.
+    RUN_NULL = RUN_PROFILE+1+PHASE_NULL
+};
+
+//Everything the HUD shows. The HUD is only redrawn when one of these changes.
+struct RENDERER_HUD
+{
+    unsigned char   level           = 0;
+    char            linesRemaining  = 0;
+    unsigned long   score           = 0;
+    unsigned char   music           = 0;
+    unsigned char   watching        = 0;    //Playback speed (0 if not watching).
+    unsigned int    time            = 0;    //Seconds into playback.
+    unsigned int    length          = 0;    //Seconds of playback in all.
+};
+
+
+class Renderer
+{
+    public:
+    Renderer(ALLEGRO_FONT* f, Atlas* a);    //Constructor. Needs a display to exist.
+    ~Renderer();                            //Destructor
+
+    void draw(Board* b, Preview* p, Hold* h, const RENDERER_HUD& hud, unsigned char uc_paused, bool b_profile);  //Draws a whole frame to the current target. Blocks are hidden while paused; the profile is shown on top if asked for.
+
+
+    //Gets
+    ALLEGRO_FONT*   getFont()               {return this->f_Font;}
+    Atlas*          getAtlas()              {return this->a_Atlas;}
+    ALLEGRO_BITMAP* getStatic()             {return this->bmp_Static;}
+    ALLEGRO_BITMAP* getHUD()                {return this->bmp_HUD;}
+    ALLEGRO_BITMAP* getStack()              {return this->bmp_Stack;}
+    TextCache*      getText()               {return this->t_Text;}
+    Profiler*       getProfiler()           {return this->p_Profiler;}
+
+    //Sets
+    void            setProfiler(Profiler* p)    {this->p_Profiler = p;}
+
+
+    private:
+    void drawStatic();                                                          //Draws the static layer into its bitmap.
+    void drawFrame(int x, int y, int w, int h);                                 //Draws a window's frame into the static layer.
+    void drawHUD(const RENDERER_HUD& hud);                                      //Draws the HUD layer into its bitmap.
+    void drawStack(Board* b);                                                   //Redraws any rows of dead blocks that changed since the last frame.
+    void drawBoard(Board* b);                                                   //Draws the dead blocks, the current pentomino and its shadow.
+    void drawProfile();                                                         //Draws the spread of every phase of a frame over the board.
+
+    //Draws the blocks of a preview or hold window, with the given number of rows, from its top left corner.
+    template<class W> void drawWindow(W* w, int rows, float x, float y)
+    {
+        for(int j = 0; j < rows; j++)
+        {
+            for(int i = 0; i < 5; i++)
+            {
+                if(w->getCell(i,j) != PENTOMINO_NULL)
+                {
+                    this->getAtlas()->drawBlock(w->getCell(i,j), x + UTIL_BLOCK_SIZE*i, y + UTIL_BLOCK_SIZE*j);
+                }
+            }
+        }
+    }
+
+    ALLEGRO_FONT*       f_Font          = nullptr;      //Font for all text. Not owned.
+    Atlas*              a_Atlas         = nullptr;      //Every block sprite. Not owned.
+    ALLEGRO_BITMAP*     bmp_Static      = nullptr;      //The whole screen, minus anything that changes.
+    ALLEGRO_BITMAP*     bmp_HUD         = nullptr;      //Everything beside the preview that changes now and then.
+    TextCache*          t_Text          = nullptr;      //Every character of the font, and every line of the HUD.
+    RENDERER_HUD        hud_Shown                   ;   //What the HUD bitmap currently shows.
+    bool                b_HUDValid      = false;        //Has the HUD bitmap been drawn at all?
+    ALLEGRO_BITMAP*     bmp_Stack       = nullptr;      //Every dead block on the board.
+    unsigned int        ui_StackRows[UTIL_GRID_HEIGHT]  ;                   //Rows the stack bitmap currently shows.
+    unsigned char       uc_StackCells[UTIL_GRID_HEIGHT][UTIL_GRID_WIDTH];   //Type of every block the stack bitmap currently shows.
+    bool                b_StackValid    = false;        //Has the stack bitmap been drawn at all?
+    Profiler*           p_Profiler      = nullptr;      //Times each part of drawing, if set. Not owned.
+};
+
+#endif //RENDERER_H
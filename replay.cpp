@@ -0,0 +1,135 @@
+#include "replay.h"
+
+Replay::Replay()
+{
+    //Allocate the whole buffer once, so recording never has to.
+    this->ui_Events = new unsigned int[REPLAY_CAPACITY];
+    this->start(0);
+}
+
+Replay::~Replay()
+{
+    delete[] this->ui_Events;
+}
+
+
+//Throws away the old recording and starts a new one.
+void Replay::start(unsigned long long ull_seed)
+{
+    this->ull_Seed = ull_seed;
+    this->ui_Count = 0;
+    this->b_Overflow = false;
+}
+
+//Appends an action, stamped with the tick it happened on.
+void Replay::record(unsigned char uc_action, unsigned int ui_tick)
+{
+    if(this->ui_Count >= REPLAY_CAPACITY)
+    {
+        //Out of room. The replay will stop short of the end of the game.
+        this->b_Overflow = true;
+        return;
+    }
+
+    this->ui_Events[this->ui_Count++] = (ui_tick << REPLAY_ACTION_BITS) | uc_action;
+}
+
+//Writes the recording to a file.
+bool Replay::save(const char* path)
+{
+    FILE* f = fopen(path, "wb");
+    if(!f)
+    {
+        return false;
+    }
+
+    //Header.
+    unsigned char h[17] = {'P','N','T','R',REPLAY_VERSION};
+    for(int i = 0; i < 8; i++)
+    {
+        h[5+i] = this->ull_Seed >> (8*i);
+    }
+    for(int i = 0; i < 4; i++)
+    {
+        h[13+i] = this->ui_Count >> (8*i);
+    }
+    bool ok = fwrite(h, 1, sizeof(h), f) == sizeof(h);
+
+    //Actions, written out a block at a time.
+    unsigned char b[4096];
+    unsigned int n = 0;
+    for(unsigned int i = 0; i < this->ui_Count && ok; i++)
+    {
+        for(int k = 0; k < 4; k++)
+        {
+            b[n++] = this->ui_Events[i] >> (8*k);
+        }
+        if(n == sizeof(b) || i+1 == this->ui_Count)
+        {
+            ok = fwrite(b, 1, n, f) == n;
+            n = 0;
+        }
+    }
+
+    return (fclose(f) == 0) && ok;
+}
+
+//Reads a recording from a file.
+bool Replay::load(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if(!f)
+    {
+        return false;
+    }
+
+    //Header.
+    unsigned char h[17];
+    if(fread(h, 1, sizeof(h), f) != sizeof(h) || h[0] != 'P' || h[1] != 'N' || h[2] != 'T' || h[3] != 'R' || h[4] != REPLAY_VERSION)
+    {
+        fclose(f);
+        return false;
+    }
+
+    unsigned long long seed = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        seed |= (unsigned long long)h[5+i] << (8*i);
+    }
+    unsigned int count = 0;
+    for(int i = 0; i < 4; i++)
+    {
+        count |= (unsigned int)h[13+i] << (8*i);
+    }
+    if(count > REPLAY_CAPACITY)
+    {
+        fclose(f);
+        return false;
+    }
+
+    //Actions.
+    this->start(seed);
+    unsigned char b[4];
+    for(unsigned int i = 0; i < count; i++)
+    {
+        if(fread(b, 1, 4, f) != 4)
+        {
+            fclose(f);
+            this->ui_Count = i;     //Keep what could be read, but report the damage.
+            return false;
+        }
+        this->ui_Events[i] = b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+
+        //Every action has to be one the game knows, and times only ever go up. Anything else can't be played back.
+        if(this->getAction(i) >= REPLAY_ACTIONS || (i > 0 && this->getTick(i) < this->getTick(i-1)))
+        {
+            fclose(f);
+            this->ui_Count = 0;
+            return false;
+        }
+    }
+    this->ui_Count = count;
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,64 @@
+/*
+
+    ==================
+    ===== REPLAY =====
+    ==================
+
+    A record of one game: the seed it was dealt from, and every action
+     taken on it in order, each stamped with the game tick it happened on.
+    Only ticks the game actually ran count, so the countdown, pauses and
+     anything else that stops the game leave no gaps, and a replay can be
+     played back to the exact tick.
+    The same seed and the same actions always play out the same game, so
+     this is all it takes to watch a game again or check its score.
+    Recording only ever appends one packed word to a buffer allocated up
+     front. Nothing touches the disk until the recording is saved.
+
+    File layout, all little endian:
+        4 bytes     "PNTR"
+        1 byte      Version
+        8 bytes     Seed
+        4 bytes     Number of actions
+        4 bytes     Each action: ticks since the start << 4 | action
+
+*/
+
+#include <cstdio>
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#define REPLAY_VERSION          3                                       //Current file version.
+#define REPLAY_CAPACITY         (1<<20)                                 //Most actions a replay can hold. Enough for hours of play.
+#define REPLAY_ACTION_BITS      4                                       //Bits of each packed word that hold the action.
+#define REPLAY_ACTIONS          8                                       //Number of different actions. Anything else in a file means it's damaged.
+
+
+class Replay
+{
+    public:
+    Replay();       //Constructor
+    ~Replay();      //Destructor
+
+    void start(unsigned long long ull_seed);    //Throws away the old recording and starts a new one.
+    void record(unsigned char uc_action, unsigned int ui_tick);   //Appends an action, stamped with the tick it happened on.
+    bool save(const char* path);                //Writes the recording to a file. False if it can't be written.
+    bool load(const char* path);                //Reads a recording from a file. False if it can't be read, isn't a replay, or holds anything a game couldn't have recorded.
+
+
+    //Gets
+    unsigned long long  getSeed()               {return this->ull_Seed;}
+    unsigned int        getCount()              {return this->ui_Count;}
+    unsigned char       getAction(unsigned int i)   {return this->ui_Events[i] & ((1u<<REPLAY_ACTION_BITS)-1);}
+    unsigned int        getTick(unsigned int i)     {return this->ui_Events[i] >> REPLAY_ACTION_BITS;}     //Ticks since the start.
+    bool                getOverflow()           {return this->b_Overflow;}
+
+
+    private:
+    unsigned long long  ull_Seed                = 0;        //Seed the game was dealt from.
+    unsigned int*       ui_Events               = nullptr;  //Every action, packed with its time.
+    unsigned int        ui_Count                = 0;        //Number of actions recorded.
+    bool                b_Overflow              = false;    //Ran out of room? Anything after that was dropped.
+};
+
+#endif //REPLAY_H
@@ -0,0 +1,159 @@
+#include "sfx.h"
+
+static_assert(SFX_NULL <= 32, "Every effect needs a bit for requests made during a frame.");
+
+SFX::SFX()
+{
+    //Nothing plays until its sample is added.
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        this->s_Samples[i] = nullptr;
+        this->uc_Next[i] = 0;
+        this->d_Last[i] = -1.0;
+        for(int v = 0; v < SFX_VOICES; v++)
+        {
+            this->si_Voices[i][v] = nullptr;
+        }
+    }
+}
+
+SFX::~SFX()
+{
+    //Voices go before the samples they play.
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        for(int v = 0; v < SFX_VOICES; v++)
+        {
+            if(this->si_Voices[i][v])
+            {
+                al_destroy_sample_instance(this->si_Voices[i][v]);
+            }
+        }
+        if(this->s_Samples[i])
+        {
+            al_destroy_sample(this->s_Samples[i]);
+        }
+    }
+}
+
+
+//Gives an effect its sample, and its voices on the default mixer. The sample is owned from then on.
+void SFX::add(unsigned char uc_sfx, ALLEGRO_SAMPLE* s)
+{
+    this->s_Samples[uc_sfx] = s;
+    if(!s)
+    {
+        return;
+    }
+    for(int v = 0; v < SFX_VOICES; v++)
+    {
+        this->si_Voices[uc_sfx][v] = al_create_sample_instance(s);
+        al_set_sample_instance_gain(this->si_Voices[uc_sfx][v], c_SFX[uc_sfx].gain);
+        al_attach_sample_instance_to_mixer(this->si_Voices[uc_sfx][v], al_get_default_mixer());
+    }
+}
+
+//Asks for an effect to be played at the end of the frame.
+void SFX::play(unsigned char uc_sfx)
+{
+    this->ui_Pending |= 1u << uc_sfx;
+}
+
+//Plays everything asked for this frame, within the limits.
+void SFX::flush()
+{
+    if(!this->ui_Pending)
+    {
+        return;
+    }
+
+    //Count what's already playing.
+    int playing = 0;
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        for(int v = 0; v < SFX_VOICES; v++)
+        {
+            playing += this->si_Voices[i][v] && al_get_sample_instance_playing(this->si_Voices[i][v]);
+        }
+    }
+
+    //Highest priority first, so the most important effects get any free voices.
+    double now = al_get_time();
+    for(int p = SFX_PRIORITIES-1; p >= 0 && this->ui_Pending; p--)
+    {
+        for(int i = 0; i < SFX_NULL; i++)
+        {
+            if(!((this->ui_Pending >> i) & 1) || c_SFX[i].priority != p)
+            {
+                continue;
+            }
+            this->ui_Pending &= ~(1u << i);
+
+            //Not loaded, or played too recently.
+            if(!this->s_Samples[i] || now - this->d_Last[i] < c_SFX[i].gap)
+            {
+                continue;
+            }
+
+            //Every voice busy. Cut off the lowest priority effect playing, if it's lower than this one.
+            if(playing >= SFX_BUDGET)
+            {
+                ALLEGRO_SAMPLE_INSTANCE* victim = nullptr;
+                int lowest = p;
+                for(int j = 0; j < SFX_NULL; j++)
+                {
+                    for(int v = 0; v < SFX_VOICES; v++)
+                    {
+                        if(c_SFX[j].priority < lowest && this->si_Voices[j][v] && al_get_sample_instance_playing(this->si_Voices[j][v]))
+                        {
+                            victim = this->si_Voices[j][v];
+                            lowest = c_SFX[j].priority;
+                        }
+                    }
+                }
+                if(!victim)
+                {
+                    continue;
+                }
+                al_stop_sample_instance(victim);
+                playing--;
+            }
+
+            //Use a free voice of this effect, or restart the one due next.
+            int v = this->uc_Next[i];
+            for(int w = 0; w < SFX_VOICES; w++)
+            {
+                if(!al_get_sample_instance_playing(this->si_Voices[i][w]))
+                {
+                    v = w;
+                    break;
+                }
+            }
+            if(al_get_sample_instance_playing(this->si_Voices[i][v]))
+            {
+                al_stop_sample_instance(this->si_Voices[i][v]);
+                playing--;
+            }
+            al_play_sample_instance(this->si_Voices[i][v]);
+            this->uc_Next[i] = (v+1)%SFX_VOICES;
+            this->d_Last[i] = now;
+            playing++;
+        }
+    }
+}
+
+//Stops every effect.
+void SFX::stop()
+{
+    for(int i = 0; i < SFX_NULL; i++)
+    {
+        for(int v = 0; v < SFX_VOICES; v++)
+        {
+            if(this->si_Voices[i][v])
+            {
+                al_stop_sample_instance(this->si_Voices[i][v]);
+            }
+        }
+    }
+    this->ui_Pending = 0;
+}
@@ -0,0 +1,108 @@
+/*
+
+    ===============
+    ===== SFX =====
+    ===============
+
+    Every sound effect, with its own voices set up once at startup.
+    Each effect gets a fixed number of sample instances attached to the
+     mixer up front, so playing one never allocates, and never competes
+     with the music for a voice.
+    Samples are added as they finish loading. An effect asked for before
+     its sample is in is simply not heard.
+    Requests made during a frame are only collected. At the end of the
+     frame each effect plays at most once, however many times it was
+     asked for, and not again until its minimum gap has passed.
+    Only so many effects ever play at once. When they all are, a new one
+     cuts off a lower priority one, or is dropped if there isn't one.
+
+*/
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_audio.h>
+
+#include <utilities.h>
+
+#ifndef SFX_H
+#define SFX_H
+
+#define SFX_VOICES          2           //Instances kept for each effect, so an effect can overlap itself once.
+#define SFX_BUDGET          8           //Most effects playing at once.
+#define SFX_PRIORITIES      5           //Levels of priority, 0 being the lowest.
+
+
+//Handles for each sound effect.
+enum e_SFX
+{
+    SFX_START_TIMER,
+    SFX_MOVE,
+    SFX_ROTATE,
+    SFX_LOCK,
+    SFX_HOLD,
+    SFX_CLEAR_SINGLE,
+    SFX_CLEAR_DOUBLE,
+    SFX_CLEAR_TRIPLE,
+    SFX_CLEAR_QUADRUPLE,
+    SFX_CLEAR_PENTRIS,
+    SFX_PAUSE,
+    SFX_UNPAUSE,
+    SFX_NOMOVE,
+    SFX_KILLBOARD,
+    SFX_NULL,
+};
+
+//How each sound effect is played.
+struct SFX_SETTINGS
+{
+    const char*     file;               //File to load it from.
+    float           gain;               //Volume.
+    unsigned char   priority;           //Higher cuts off lower when every voice is busy.
+    double          gap;                //Least time between two plays, in seconds.
+};
+
+static const SFX_SETTINGS c_SFX[SFX_NULL] =
+{
+    //File                  Gain                    Priority    Gap
+    {"sfx_timer.wav",       UTIL_SFX_VOLUME,        4,          0.0},
+    {"sfx_move.wav",        UTIL_SFX_VOLUME-0.3,    0,          0.03},
+    {"sfx_rotate.wav",      UTIL_SFX_VOLUME-0.3,    1,          0.03},
+    {"sfx_lock.wav",        UTIL_SFX_VOLUME,        2,          0.0},
+    {"sfx_hold.wav",        UTIL_SFX_VOLUME,        2,          0.0},
+    {"sfx_clear_1.wav",     UTIL_SFX_VOLUME,        3,          0.0},
+    {"sfx_clear_2.wav",     UTIL_SFX_VOLUME,        3,          0.0},
+    {"sfx_clear_3.wav",     UTIL_SFX_VOLUME,        3,          0.0},
+    {"sfx_clear_4.wav",     UTIL_SFX_VOLUME,        3,          0.0},
+    {"sfx_clear_5.wav",     UTIL_SFX_VOLUME,        3,          0.0},
+    {"sfx_pause.wav",       UTIL_SFX_VOLUME,        4,          0.0},
+    {"sfx_unpause.wav",     UTIL_SFX_VOLUME,        4,          0.0},
+    {"sfx_nomove.wav",      UTIL_SFX_VOLUME,        0,          0.05},
+    {"sfx_killboard.wav",   UTIL_SFX_VOLUME,        1,          0.0},
+};
+
+
+class SFX
+{
+    public:
+    SFX();      //Constructor. Needs the audio addon and a mixer to exist.
+    ~SFX();     //Destructor
+
+    void add(unsigned char uc_sfx, ALLEGRO_SAMPLE* s);      //Gives an effect its sample, and its voices. The sample is owned from then on.
+    void play(unsigned char uc_sfx);                        //Asks for an effect to be played at the end of the frame.
+    void flush();                                           //Plays everything asked for this frame, within the limits.
+    void stop();                                            //Stops every effect.
+
+
+    //Gets
+    ALLEGRO_SAMPLE*             getSample(int i)            {return this->s_Samples[i];}
+    ALLEGRO_SAMPLE_INSTANCE*    getVoice(int i, int v)      {return this->si_Voices[i][v];}
+
+
+    private:
+    ALLEGRO_SAMPLE*             s_Samples[SFX_NULL]                 ;       //Every effect, decoded.
+    ALLEGRO_SAMPLE_INSTANCE*    si_Voices[SFX_NULL][SFX_VOICES]     ;       //Every voice of every effect.
+    unsigned char               uc_Next[SFX_NULL]                   ;       //Voice each effect uses next, if none are free.
+    double                      d_Last[SFX_NULL]                    ;       //When each effect last played.
+    unsigned int                ui_Pending                  = 0;            //Effects asked for this frame, one bit each.
+};
+
+#endif //SFX_H
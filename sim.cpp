@@ -0,0 +1,410 @@
+/*
+
+    ===============
+    ===== SIM =====
+    ===============
+
+    Plays batches of games with no window, as fast as the machine allows.
+    Every game runs the real rules: the same bag, the same moves, and the
+     same scoring as the board, with a placement policy standing in for
+     the player. Games are shared out across a pool of threads, and each
+     game's result is written out as CSV or JSON once the batch is done.
+    Placements are played with the inputs a player would press. Any that
+     don't arrive are counted, and make the run fail.
+
+    Usage:
+        pentris-sim [options]
+            --games N       Number of games to play. Default 1000.
+            --pieces N      Stop each game after N pentominoes. Default 0, no limit.
+            --seed N        Seed of the first game; game i uses seed+i. Default 1.
+            --policy P      random, drop, or greedy. Default greedy.
+            --threads N     Worker threads. Default 0, one per core.
+            --format F      csv or json. Default csv.
+            --out FILE      Write results here instead of standard output.
+            --replay FILE   Play back a recorded game instead, and check its result.
+
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <random>
+
+#include <utilities.h>
+#include <game.h>
+#include <movegen.h>
+#include <playback.h>
+
+#define SIM_POLICY_STREAM       0x9E3779B9                              //Mixed into each game's seed to seed the policy, apart from the bag.
+
+enum e_Policy
+{
+    POLICY_RANDOM,  //Any reachable placement.
+    POLICY_DROP,    //Hard drop straight from spawn.
+    POLICY_GREEDY,  //Best looking board after one placement.
+    POLICY_NULL = 99
+};
+
+static const char* c_Policies[] = {"random", "drop", "greedy"};
+
+struct SIM_OPTIONS
+{
+    unsigned int        games       = 1000;
+    unsigned int        pieces      = 0;
+    unsigned long long  seed        = 1;
+    unsigned char       policy      = POLICY_GREEDY;
+    unsigned int        threads     = 0;
+    bool                json        = false;
+    const char*         out         = nullptr;
+    const char*         replay      = nullptr;
+};
+
+struct SIM_RESULT
+{
+    unsigned long long  seed;
+    unsigned long       score;
+    unsigned int        lines;
+    unsigned int        level;
+    unsigned int        pieces;
+    unsigned int        missed;     //Placements whose inputs didn't arrive on the board. Always 0 unless the move generator and the board disagree.
+};
+
+
+//Rates the rows left behind by a placement. Higher is better.
+static double rate(const unsigned int* rows, int lines)
+{
+    //Column heights, found top down.
+    int heights[UTIL_GRID_WIDTH] = {};
+    unsigned int found = 0;
+    int holes = 0;
+    for(int r = 0; r < UTIL_GRID_ROWS; r++)
+    {
+        for(int x = 0; x < UTIL_GRID_WIDTH; x++)
+        {
+            if((rows[r] >> x) & 1)
+            {
+                if(!((found >> x) & 1))
+                {
+                    heights[x] = UTIL_GRID_ROWS - r;
+                }
+            }
+            else if((found >> x) & 1)
+            {
+                holes++;    //Empty cell under a filled one.
+            }
+        }
+        found |= rows[r];
+    }
+
+    int total = 0;
+    int bumps = 0;
+    for(int x = 0; x < UTIL_GRID_WIDTH; x++)
+    {
+        total += heights[x];
+        if(x > 0)
+        {
+            bumps += abs(heights[x] - heights[x-1]);
+        }
+    }
+
+    return 0.76*lines - 0.51*total - 0.36*holes - 0.18*bumps;
+}
+
+//Draws a number from 0 to n-1, each equally likely. Done by hand like the bag's, so every standard library draws the same.
+static unsigned int roll(std::mt19937_64& rng, unsigned int n)
+{
+    //Throw away the lowest 2^64 mod n values, so what's left divides evenly by n.
+    unsigned long long floor = (0ULL - n) % n;
+    unsigned long long r;
+    do
+    {
+        r = rng();
+    }
+    while(r < floor);
+
+    return r % n;
+}
+
+//Picks a placement out of everything the move generator found.
+static int choose(MoveGen* gen, Board* b, unsigned char policy, std::mt19937_64& rng)
+{
+    int n = gen->getCount();
+    switch(policy)
+    {
+        case POLICY_RANDOM:
+            return roll(rng, n);
+
+        case POLICY_DROP:
+        {
+            //The placement a hard drop from spawn would reach.
+            Pentomino* p = b->getCurrentPentomino();
+            for(int i = 0; i < n; i++)
+            {
+                const MOVEGEN_PLACEMENT& m = gen->getPlacement(i);
+                if(m.x == p->getX() && m.y == p->getY()+p->getShadow() && m.o == p->getOrientation()%4)
+                {
+                    return i;
+                }
+            }
+            return 0;
+        }
+
+        case POLICY_GREEDY:default:
+        {
+            int best = 0;
+            double bestRating = -1e30;
+            unsigned int rows[UTIL_GRID_ROWS];
+            for(int i = 0; i < n; i++)
+            {
+                int l = gen->result(i, rows);
+                double r = rate(rows, l);
+                if(r > bestRating)
+                {
+                    best = i;
+                    bestRating = r;
+                }
+            }
+            return best;
+        }
+    }
+}
+
+//Plays one game to the end, or until the piece limit.
+static SIM_RESULT play(Game* g, MoveGen* gen, const SIM_OPTIONS& o, unsigned long long seed)
+{
+    //The policy draws from a stream of its own. Seeded the same as the bag, its picks would just follow the pentominoes dealt.
+    std::seed_seq s{(unsigned int)seed, (unsigned int)(seed >> 32), (unsigned int)SIM_POLICY_STREAM};
+    std::mt19937_64 rng(s);
+    g->newGame(seed);
+
+    unsigned int pieces = 0;
+    unsigned int missed = 0;
+    while(!g->getGameOver() && (o.pieces == 0 || pieces < o.pieces))
+    {
+        Board* b = g->getBoard();
+        if(gen->generate(b) == 0)
+        {
+            break;  //Nowhere to go.
+        }
+
+        //Locks wherever the inputs left it, just as the game would.
+        missed += !gen->play(b, choose(gen, b, o.policy, rng));
+        g->lock();
+        pieces++;
+    }
+
+    SIM_RESULT r;
+    r.seed = seed;
+    r.score = g->getBoard()->getScore();
+    r.lines = g->getBoard()->getLines();
+    r.level = g->getBoard()->getLevel();
+    r.pieces = pieces;
+    r.missed = missed;
+    return r;
+}
+
+//Works through games until there are none left.
+static void work(const SIM_OPTIONS* o, std::atomic<unsigned int>* next, SIM_RESULT* results)
+{
+    //Each worker owns its own game and search, so nothing is shared but the counter.
+    Game* g = new Game();
+    MoveGen* gen = new MoveGen();
+
+    for(unsigned int i = (*next)++; i < o->games; i = (*next)++)
+    {
+        results[i] = play(g, gen, *o, o->seed + i);
+    }
+
+    delete gen;
+    delete g;
+}
+
+//Plays a recorded game back to the end, with no window. False if it can't be read.
+static bool watch(const SIM_OPTIONS& o, FILE* f)
+{
+    Playback* p = new Playback();
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    bool ok = p->load(o.replay);
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if(ok)
+    {
+        Board* b = p->getGame()->getBoard();
+        if(o.json)
+        {
+            fprintf(f, "[\n  {\"replay\": \"%s\", \"seed\": %llu, \"score\": %lu, \"lines\": %u, \"level\": %u, \"actions\": %u, \"ticks\": %u}\n]\n",
+                    o.replay, p->getReplay()->getSeed(), b->getScore(), b->getLines(), b->getLevel(), p->getReplay()->getCount(), p->getLength());
+        }
+        else
+        {
+            fprintf(f, "replay,seed,score,lines,level,actions,ticks\n");
+            fprintf(f, "%s,%llu,%lu,%u,%u,%u,%u\n", o.replay, p->getReplay()->getSeed(), b->getScore(), b->getLines(), b->getLevel(), p->getReplay()->getCount(), p->getLength());
+        }
+
+        //How much faster than the game was played.
+        fprintf(stderr, "%u actions over %.1f s of play in %.4f s: %.0fx real time, %u keyframes\n",
+                p->getReplay()->getCount(), p->getLength()/(double)UTIL_TICK_RATE, seconds, seconds > 0 ? p->getLength()/(double)UTIL_TICK_RATE/seconds : 0.0, p->getKeyframes());
+    }
+
+    delete p;
+    return ok;
+}
+
+//Reads the command line. False if something is wrong with it.
+static bool parse(int argc, char** argv, SIM_OPTIONS& o)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        const char* a = argv[i];
+        const char* v = (i+1 < argc) ? argv[i+1] : nullptr;
+        if(!v)
+        {
+            return false;
+        }
+
+        if(!strcmp(a, "--games"))           {o.games = strtoul(v, nullptr, 10);}
+        else if(!strcmp(a, "--pieces"))     {o.pieces = strtoul(v, nullptr, 10);}
+        else if(!strcmp(a, "--seed"))       {o.seed = strtoull(v, nullptr, 10);}
+        else if(!strcmp(a, "--threads"))    {o.threads = strtoul(v, nullptr, 10);}
+        else if(!strcmp(a, "--out"))        {o.out = v;}
+        else if(!strcmp(a, "--replay"))     {o.replay = v;}
+        else if(!strcmp(a, "--format"))
+        {
+            if(strcmp(v, "csv") && strcmp(v, "json"))
+            {
+                return false;
+            }
+            o.json = !strcmp(v, "json");
+        }
+        else if(!strcmp(a, "--policy"))
+        {
+            o.policy = POLICY_NULL;
+            for(int p = 0; p < 3; p++)
+            {
+                if(!strcmp(v, c_Policies[p]))
+                {
+                    o.policy = p;
+                }
+            }
+            if(o.policy == POLICY_NULL)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+    SIM_OPTIONS o;
+    if(!parse(argc, argv, o))
+    {
+        fprintf(stderr, "usage: %s [--games N] [--pieces N] [--seed N] [--policy random|drop|greedy]\n"
+                        "          [--threads N] [--format csv|json] [--out FILE] [--replay FILE]\n", argv[0]);
+        return 2;
+    }
+
+    FILE* f = o.out ? fopen(o.out, "w") : stdout;
+    if(!f)
+    {
+        fprintf(stderr, "cannot write %s\n", o.out);
+        return 2;
+    }
+
+    //A recorded game takes the place of the batch.
+    if(o.replay)
+    {
+        bool ok = watch(o, f);
+        if(o.out)
+        {
+            fclose(f);
+        }
+        if(!ok)
+        {
+            fprintf(stderr, "cannot read replay %s\n", o.replay);
+            return 1;
+        }
+        return 0;
+    }
+
+    //Share the games out across the pool.
+    unsigned int threads = o.threads ? o.threads : std::thread::hardware_concurrency();
+    threads = threads ? threads : 1;
+    std::vector<SIM_RESULT> results(o.games);
+    std::atomic<unsigned int> next(0);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> pool;
+    for(unsigned int t = 0; t < threads; t++)
+    {
+        pool.push_back(std::thread(work, &o, &next, results.data()));
+    }
+    for(std::thread& t : pool)
+    {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    //Write every game in order, whichever thread played it.
+    if(o.json)
+    {
+        fprintf(f, "[\n");
+    }
+    else
+    {
+        fprintf(f, "game,seed,score,lines,level,pieces,missed\n");
+    }
+
+    unsigned long long pieces = 0;
+    unsigned long long missed = 0;
+    double score = 0;
+    for(unsigned int i = 0; i < o.games; i++)
+    {
+        const SIM_RESULT& r = results[i];
+        pieces += r.pieces;
+        missed += r.missed;
+        score += r.score;
+        if(o.json)
+        {
+            fprintf(f, "  {\"game\": %u, \"seed\": %llu, \"score\": %lu, \"lines\": %u, \"level\": %u, \"pieces\": %u, \"missed\": %u}%s\n",
+                    i, r.seed, r.score, r.lines, r.level, r.pieces, r.missed, i+1 < o.games ? "," : "");
+        }
+        else
+        {
+            fprintf(f, "%u,%llu,%lu,%u,%u,%u,%u\n", i, r.seed, r.score, r.lines, r.level, r.pieces, r.missed);
+        }
+    }
+    if(o.json)
+    {
+        fprintf(f, "]\n");
+    }
+    if(o.out)
+    {
+        fclose(f);
+    }
+
+    //Summary goes to the console, out of the way of the results.
+    fprintf(stderr, "%u games (%s) on %u threads in %.2f s: %.0f games/s, %.0f pieces/s, mean score %.1f\n",
+            o.games, c_Policies[o.policy], threads, seconds, o.games/seconds, pieces/seconds, o.games ? score/o.games : 0.0);
+
+    //Any placement that didn't arrive means the results don't match real play.
+    if(missed)
+    {
+        fprintf(stderr, "%llu placements did not arrive where the move generator said\n", missed);
+        return 1;
+    }
+    return 0;
+}
+//////////////////////////////////////////////////
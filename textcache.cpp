@@ -0,0 +1,90 @@
+#include "textcache.h"
+
+TextCache::TextCache(ALLEGRO_FONT* f)
+{
+    this->f_Font = f;
+    this->i_LineHeight = al_get_font_line_height(f);
+
+    //Measure every character, leaving a pixel between each so none bleed into the next.
+    int width = 0;
+    for(int c = 0; c < TEXTCACHE_GLYPHS; c++)
+    {
+        int bx = 0, by = 0, bw = 0, bh = 0;
+        al_get_glyph_dimensions(f, TEXTCACHE_FIRST+c, &bx, &by, &bw, &bh);
+        this->g_Glyphs[c].x = width;
+        this->g_Glyphs[c].w = bw;
+        this->g_Glyphs[c].offset = bx;
+        width += bw + 1;
+    }
+
+    //Rasterize every character once, in white, so it can be tinted any color.
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    this->bmp_Glyphs = al_create_bitmap(width > 0 ? width : 1, this->i_LineHeight);
+    al_set_target_bitmap(this->bmp_Glyphs);
+    al_clear_to_color(al_map_rgba(0,0,0,0));
+    for(int c = 0; c < TEXTCACHE_GLYPHS; c++)
+    {
+        al_draw_glyph(f, al_map_rgb(255,255,255), this->g_Glyphs[c].x - this->g_Glyphs[c].offset, 0, TEXTCACHE_FIRST+c);
+    }
+    al_set_target_bitmap(target);
+}
+
+TextCache::~TextCache()
+{
+    al_destroy_bitmap(this->bmp_Glyphs);
+    this->bmp_Glyphs = nullptr;
+}
+
+
+//Lays a run out from printf style text, unless its key hasn't changed.
+void TextCache::setRun(int i, long long ll_key, const char* format, ...)
+{
+    TEXTCACHE_RUN& r = this->r_Runs[i];
+    if(r.valid && r.key == ll_key)
+    {
+        return;
+    }
+
+    char text[TEXTCACHE_LENGTH+1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    //Place each character after the last, kerned against it. Anything not in the cache is skipped.
+    r.n = 0;
+    int pen = 0;
+    int last = ALLEGRO_NO_KERNING;
+    for(const char* c = text; *c; c++)
+    {
+        if(*c < TEXTCACHE_FIRST || *c > TEXTCACHE_LAST)
+        {
+            continue;
+        }
+        if(last != ALLEGRO_NO_KERNING)
+        {
+            pen += al_get_glyph_advance(this->f_Font, last, *c);
+        }
+        r.glyph[r.n] = *c - TEXTCACHE_FIRST;
+        r.x[r.n] = pen;
+        r.n++;
+        last = *c;
+    }
+
+    r.key = ll_key;
+    r.valid = true;
+}
+
+//Draws a run with its pen starting at (x,y).
+void TextCache::drawRun(int i, ALLEGRO_COLOR c, float x, float y)
+{
+    const TEXTCACHE_RUN& r = this->r_Runs[i];
+    for(int n = 0; n < r.n; n++)
+    {
+        const TEXTCACHE_GLYPH& g = this->g_Glyphs[r.glyph[n]];
+        if(g.w)
+        {
+            al_draw_tinted_bitmap_region(this->bmp_Glyphs, c, g.x, 0, g.w, this->i_LineHeight, x + r.x[n] + g.offset, y, 0);
+        }
+    }
+}
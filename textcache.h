@@ -0,0 +1,76 @@
+/*
+
+    ======================
+    ===== TEXT CACHE =====
+    ======================
+
+    Every printable character of a font, rasterized once into one bitmap.
+    Text drawn from here is one bitmap region per character, all out of
+     the same bitmap, so a whole screen of it goes out in one held batch
+     instead of through the font each time.
+    Lines that show a changing number are kept as runs: laid out once,
+     glyph by glyph, and laid out again only when their number changes.
+
+*/
+
+#include <cstdio>
+#include <cstdarg>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+
+#include <utilities.h>
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#define TEXTCACHE_FIRST     ' '                                         //First character in the cache.
+#define TEXTCACHE_LAST      '~'                                         //Last character in the cache.
+#define TEXTCACHE_GLYPHS    (TEXTCACHE_LAST-TEXTCACHE_FIRST+1)          //Number of characters in the cache.
+#define TEXTCACHE_LENGTH    48                                          //Longest run, in characters.
+#define TEXTCACHE_RUNS      24                                          //Number of runs kept.
+
+
+//Where a character sits in the cache, and how to place it.
+struct TEXTCACHE_GLYPH
+{
+    short   x           = 0;    //Left edge in the cache bitmap.
+    short   w           = 0;    //Width in the cache bitmap.
+    short   offset      = 0;    //Distance from the pen to the left edge.
+};
+
+//A line of text, laid out and ready to draw.
+struct TEXTCACHE_RUN
+{
+    long long       key                     = 0;        //Whatever the text was made from. The run is only laid out again if this changes.
+    bool            valid                   = false;    //Has the run been laid out at all?
+    unsigned char   n                       = 0;        //Number of characters.
+    unsigned char   glyph[TEXTCACHE_LENGTH] ;           //Each character, as an index into the cache.
+    short           x[TEXTCACHE_LENGTH]     ;           //Each character's pen position from the start of the line.
+};
+
+
+class TextCache
+{
+    public:
+    TextCache(ALLEGRO_FONT* f);     //Constructor. Needs a display to exist.
+    ~TextCache();                   //Destructor
+
+    void setRun(int i, long long ll_key, const char* format, ...);               //Lays a run out from printf style text, unless its key hasn't changed.
+    void drawRun(int i, ALLEGRO_COLOR c, float x, float y);                     //Draws a run with its pen starting at (x,y).
+
+
+    //Gets
+    ALLEGRO_BITMAP*     getSprite()         {return this->bmp_Glyphs;}
+    int                 getLineHeight()     {return this->i_LineHeight;}
+
+
+    private:
+    ALLEGRO_BITMAP*     bmp_Glyphs              = nullptr;  //Every character, left to right.
+    int                 i_LineHeight            = 0;        //Height of every character in the cache.
+    TEXTCACHE_GLYPH     g_Glyphs[TEXTCACHE_GLYPHS]  ;       //Where each character is.
+    TEXTCACHE_RUN       r_Runs[TEXTCACHE_RUNS]      ;       //Every run.
+    ALLEGRO_FONT*       f_Font                  = nullptr;  //Font the cache was made from, for kerning. Not owned.
+};
+
+#endif //TEXTCACHE_H
@@ -0,0 +1,221 @@
+#include "tracer.h"
+
+//The calling thread's place in the trace.
+struct TRACER_THREAD
+{
+    Tracer*         tracer      = nullptr;      //Tracer its chunk belongs to.
+    unsigned int    trace       = 0;            //Trace its chunk belongs to.
+    TRACER_CHUNK*   chunk       = nullptr;      //Chunk it's filling.
+    unsigned int    id          = 0;            //Its number in the trace.
+};
+
+static thread_local TRACER_THREAD tt_Thread;
+
+Tracer::Tracer()
+{
+}
+
+Tracer::~Tracer()
+{
+    this->stop();
+}
+
+
+//Starts writing a trace to a file.
+bool Tracer::start(const char* path)
+{
+    this->stop();
+
+    this->f_Trace = fopen(path, "w");
+    if(!this->f_Trace)
+    {
+        return false;
+    }
+    fprintf(this->f_Trace, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    this->tp_Start = std::chrono::steady_clock::now();
+    this->ui_Trace++;
+    this->ui_Threads = 0;
+    this->b_Stop = false;
+    this->b_First = true;
+    this->t_Writer = std::thread(&Tracer::write, this);
+    this->b_Active.store(true, std::memory_order_release);
+    return true;
+}
+
+//Writes out everything traced and closes the file.
+void Tracer::stop()
+{
+    if(!this->getActive())
+    {
+        return;
+    }
+    this->b_Active.store(false, std::memory_order_relaxed);
+
+    //Hand over every chunk still being filled, then let the writer finish.
+    {
+        std::lock_guard<std::mutex> lock(this->m_Lock);
+        this->v_Full.insert(this->v_Full.end(), this->v_Open.begin(), this->v_Open.end());
+        this->v_Open.clear();
+        this->b_Stop = true;
+    }
+    this->c_Ready.notify_one();
+    this->t_Writer.join();
+
+    fprintf(this->f_Trace, "\n]}\n");
+    fclose(this->f_Trace);
+    this->f_Trace = nullptr;
+
+    for(unsigned int i = 0; i < this->v_Free.size(); i++)
+    {
+        delete this->v_Free[i];
+    }
+    this->v_Free.clear();
+}
+
+//Names the calling thread in the trace.
+void Tracer::name(const char* thread)
+{
+    this->add('M', thread, nullptr, 0);
+}
+
+//Begins a span on the calling thread.
+void Tracer::begin(const char* span)
+{
+    this->add('B', span, nullptr, 0);
+}
+
+//Ends the span last begun on the calling thread.
+void Tracer::end(const char* span)
+{
+    this->add('E', span, nullptr, 0);
+}
+
+//Marks an event on the calling thread.
+void Tracer::instant(const char* event, const char* key, long long value)
+{
+    this->add('i', event, key, value);
+}
+
+
+//Adds an event to the calling thread's chunk.
+void Tracer::add(char type, const char* name, const char* key, long long value)
+{
+    if(!this->b_Active.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    //First event from this thread in this trace, or its last chunk filled up.
+    TRACER_THREAD& t = tt_Thread;
+    if(t.tracer != this || t.trace != this->ui_Trace)
+    {
+        t.tracer = this;
+        t.trace = this->ui_Trace;
+        t.chunk = this->take(0);
+        t.id = t.chunk->thread;
+    }
+    else if(t.chunk->n == TRACER_EVENTS)
+    {
+        this->hand(t.chunk);
+        t.chunk = this->take(t.id);
+    }
+
+    TRACER_EVENT& e = t.chunk->events[t.chunk->n++];
+    e.type = type;
+    e.name = name;
+    e.key = key;
+    e.value = value;
+    e.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->tp_Start).count();
+}
+
+//Gets an empty chunk for a thread, numbering the thread if it's new.
+TRACER_CHUNK* Tracer::take(unsigned int ui_thread)
+{
+    std::lock_guard<std::mutex> lock(this->m_Lock);
+
+    TRACER_CHUNK* c = nullptr;
+    if(this->v_Free.empty())
+    {
+        c = new TRACER_CHUNK();
+    }
+    else
+    {
+        c = this->v_Free.back();
+        this->v_Free.pop_back();
+    }
+    c->n = 0;
+    c->thread = ui_thread ? ui_thread : ++this->ui_Threads;
+    this->v_Open.push_back(c);
+    return c;
+}
+
+//Hands a chunk to the writer.
+void Tracer::hand(TRACER_CHUNK* c)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_Lock);
+        for(unsigned int i = 0; i < this->v_Open.size(); i++)
+        {
+            if(this->v_Open[i] == c)
+            {
+                this->v_Open[i] = this->v_Open.back();
+                this->v_Open.pop_back();
+                break;
+            }
+        }
+        this->v_Full.push_back(c);
+    }
+    this->c_Ready.notify_one();
+}
+
+//Writes chunks as they come in.
+void Tracer::write()
+{
+    std::vector<TRACER_CHUNK*> chunks;
+    std::unique_lock<std::mutex> lock(this->m_Lock);
+    while(true)
+    {
+        this->c_Ready.wait(lock, [this]{return !this->v_Full.empty() || this->b_Stop;});
+        if(this->v_Full.empty())
+        {
+            break;
+        }
+        chunks.swap(this->v_Full);
+
+        //Write without holding the lock, so no thread being traced waits on the disk.
+        lock.unlock();
+        for(unsigned int i = 0; i < chunks.size(); i++)
+        {
+            const TRACER_CHUNK* c = chunks[i];
+            for(unsigned int j = 0; j < c->n; j++)
+            {
+                const TRACER_EVENT& e = c->events[j];
+                if(!this->b_First)
+                {
+                    fputs(",\n", this->f_Trace);
+                }
+                this->b_First = false;
+                if(e.type == 'M')
+                {
+                    fprintf(this->f_Trace, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", c->thread, e.name);
+                    continue;
+                }
+                fprintf(this->f_Trace, "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lld.%03lld,\"pid\":1,\"tid\":%u", e.name, e.type, e.ns/1000, e.ns%1000, c->thread);
+                if(e.type == 'i')
+                {
+                    fputs(",\"s\":\"t\"", this->f_Trace);
+                }
+                if(e.key)
+                {
+                    fprintf(this->f_Trace, ",\"args\":{\"%s\":%lld}", e.key, e.value);
+                }
+                fputs("}", this->f_Trace);
+            }
+        }
+        lock.lock();
+
+        this->v_Free.insert(this->v_Free.end(), chunks.begin(), chunks.end());
+        chunks.clear();
+    }
+}
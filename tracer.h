@@ -0,0 +1,91 @@
+/*
+
+    ==================
+    ===== TRACER =====
+    ==================
+
+    Writes spans and events as they happen to a Chrome trace file, which
+     Perfetto and chrome://tracing can open.
+    Each thread fills its own chunk of events, with no lock, until the
+     chunk is full. Full chunks are handed to a writer thread, which
+     turns them into JSON in the background, and are then reused. The
+     threads being traced only ever take a lock once per chunk.
+    Names are never copied, so they have to outlive the trace: string
+     literals, or tables like c_Phases.
+    Until a trace is started, every call returns straight away.
+
+*/
+
+#include <cstdio>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#define TRACER_EVENTS           4096                                    //Events in each chunk.
+
+
+//One span beginning or ending, or one event.
+struct TRACER_EVENT
+{
+    const char*     name        = nullptr;      //What happened.
+    const char*     key         = nullptr;      //Name of its value, if any.
+    long long       value       = 0;            //Its value.
+    long long       ns          = 0;            //When, since the trace started.
+    char            type        = 'i';          //'B' begins a span, 'E' ends one, 'i' is an event, 'M' names the thread.
+};
+
+//A thread's events, in order.
+struct TRACER_CHUNK
+{
+    TRACER_EVENT    events[TRACER_EVENTS]   ;           //Events so far.
+    unsigned int    n                       = 0;        //Number of events so far.
+    unsigned int    thread                  = 0;        //Thread that wrote them.
+};
+
+
+class Tracer
+{
+    public:
+    Tracer();       //Constructor
+    ~Tracer();      //Destructor. Stops any trace.
+
+    bool start(const char* path);                       //Starts writing a trace to a file. False if it can't be written.
+    void stop();                                        //Writes out everything traced and closes the file. Every other thread being traced has to be done.
+    void name(const char* thread);                      //Names the calling thread in the trace.
+    void begin(const char* span);                       //Begins a span on the calling thread.
+    void end(const char* span);                         //Ends the span last begun on the calling thread.
+    void instant(const char* event, const char* key = nullptr, long long value = 0);   //Marks an event on the calling thread, with a value if given a name for it.
+
+
+    //Gets
+    bool                getActive()             {return this->b_Active.load(std::memory_order_relaxed);}
+
+
+    private:
+    void add(char type, const char* name, const char* key, long long value);   //Adds an event to the calling thread's chunk.
+    TRACER_CHUNK* take(unsigned int ui_thread);                                 //Gets an empty chunk for a thread, numbering the thread if it's 0. Locks.
+    void hand(TRACER_CHUNK* c);                                                 //Hands a chunk to the writer. Locks.
+    void write();                                                               //Writes chunks as they come in. Runs on the writer thread.
+
+    FILE*                               f_Trace             = nullptr;      //File being written.
+    std::atomic<bool>                   b_Active            {false};        //Is a trace being written?
+    unsigned int                        ui_Trace            = 0;            //Which trace this is. Chunks left over from an earlier one are dropped.
+    unsigned int                        ui_Threads          = 0;            //Threads traced so far.
+    std::chrono::steady_clock::time_point   tp_Start        ;               //When the trace started.
+    std::thread                         t_Writer            ;               //Writes chunks out.
+    std::mutex                          m_Lock              ;               //Guards everything below.
+    std::condition_variable             c_Ready             ;               //Signalled when a chunk is handed over, or the trace stops.
+    std::vector<TRACER_CHUNK*>          v_Full              ;               //Chunks waiting to be written.
+    std::vector<TRACER_CHUNK*>          v_Free              ;               //Chunks written and ready to reuse.
+    std::vector<TRACER_CHUNK*>          v_Open              ;               //Chunks threads are filling.
+    bool                                b_Stop              = false;        //Should the writer finish up?
+    bool                                b_First             = true;         //Nothing written yet? Every event after the first needs a comma.
+};
+
+#endif //TRACER_H